@@ -0,0 +1,72 @@
+#include <db/ChecksummedDbFile.hpp>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+/**
+ * Measures the cost of page checksums: sealing and verifying pages held in memory, then reading pages back
+ * through a ChecksummedDbFile from the page cache, where the verification has to stay under 1 us per 4 KiB page.
+ * Usage: checksum_bench [pages] [rounds]
+ */
+
+template <typename F> static double timeRounds(size_t rounds, F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < rounds; i++) {
+    f();
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char *name, double nanos, size_t pages) {
+  std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(10) << nanos / pages << " ns/page" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  size_t numPages = argc > 1 ? std::stoul(argv[1]) : 1024;
+  size_t rounds = argc > 2 ? std::stoul(argv[2]) : 10;
+  const size_t slot = db::sealedSize(db::DEFAULT_PAGE_SIZE);
+  std::vector<db::Page> pages(numPages);
+  std::mt19937 rng(1);
+  for (db::Page &page : pages) {
+    std::generate(page.begin(), page.end(), [&] { return static_cast<char>(rng()); });
+  }
+  std::vector<char> slots(numPages * slot);
+
+  uint64_t lsn = 1;
+  double seal = timeRounds(rounds, [&] {
+    for (size_t i = 0; i < numPages; i++) {
+      db::sealPage(pages[i], lsn++, {slots.data() + i * slot, slot});
+    }
+  });
+  size_t valid = 0;
+  double verify = timeRounds(rounds, [&] {
+    for (size_t i = 0; i < numPages; i++) {
+      valid += db::verifyPage({slots.data() + i * slot, slot}) == db::PageStatus::Valid;
+    }
+  });
+
+  std::string path = (std::filesystem::temp_directory_path() / "checksum_bench").string();
+  double read;
+  {
+    db::ChecksummedDbFile file("bench", path);
+    for (size_t i = 0; i < numPages; i++) {
+      file.writePage(pages[i], i);
+    }
+    db::Page page;
+    read = timeRounds(rounds, [&] {
+      for (size_t i = 0; i < numPages; i++) {
+        file.readPage(page, i);
+      }
+    });
+  }
+  std::filesystem::remove(path);
+
+  report("seal", seal, numPages * rounds);
+  report("verify", verify, numPages * rounds);
+  report("readPage", read, numPages * rounds);
+  return valid == numPages * rounds ? 0 : 1;
+}
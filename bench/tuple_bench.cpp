@@ -0,0 +1,91 @@
+#include <db/StaticTupleDesc.hpp>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+/**
+ * Compares the generic TupleDesc path with the StaticTupleDesc specialization of the same schema on tuple pages
+ * held in memory: serializing the pages, scanning them to aggregate two fields, and filtering on one field.
+ * Usage: tuple_bench [pages] [rounds]
+ */
+
+using Schema = db::StaticTupleDesc<int, double, std::string, int>;
+
+template <typename F> static double timeRounds(size_t rounds, F &&f) {
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < rounds; i++) {
+    f();
+  }
+  return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char *name, double generic, double specialized, size_t tuples) {
+  std::cout << std::left << std::setw(12) << name << std::right << std::fixed << std::setprecision(2)
+            << std::setw(10) << generic / tuples << " ns" << std::setw(10) << specialized / tuples << " ns"
+            << std::setw(9) << generic / specialized << "x" << std::endl;
+}
+
+int main(int argc, char **argv) {
+  size_t numPages = argc > 1 ? std::stoul(argv[1]) : 1024;
+  size_t rounds = argc > 2 ? std::stoul(argv[2]) : 10;
+  db::TupleDesc td = Schema::runtime();
+  size_t perPage = Schema::pageCapacity(db::DEFAULT_PAGE_SIZE);
+  size_t tuples = numPages * perPage * rounds;
+  std::vector<db::Page> pages(numPages);
+
+  double generic = timeRounds(rounds, [&] {
+    int key = 0;
+    for (db::Page &page : pages) {
+      db::setTupleCount(page, 0);
+      for (size_t i = 0; i < perPage; i++, key++) {
+        td.appendTuple(page, db::Tuple({key, key * 0.5, std::string("name"), key % 10}));
+      }
+    }
+  });
+  double specialized = timeRounds(rounds, [&] {
+    int key = 0;
+    for (db::Page &page : pages) {
+      db::setTupleCount(page, 0);
+      for (size_t i = 0; i < perPage; i++, key++) {
+        Schema::appendTuple(page, key, key * 0.5, "name", key % 10);
+      }
+    }
+  });
+
+  std::cout << std::left << std::setw(12) << "" << std::right << std::setw(13) << "generic" << std::setw(13)
+            << "specialized" << std::setw(10) << "speedup" << std::endl;
+  report("serialize", generic, specialized, tuples);
+
+  volatile double sink = 0;
+  generic = timeRounds(rounds, [&] {
+    double sum = 0;
+    for (const db::Page &page : pages) {
+      td.scanPage(page, [&](const db::Tuple &tuple) {
+        sum += std::get<int>(tuple.getField(0)) + std::get<double>(tuple.getField(1));
+      });
+    }
+    sink = sum;
+  });
+  specialized = timeRounds(rounds, [&] {
+    double sum = 0;
+    for (const db::Page &page : pages) {
+      Schema::scanPage(page, [&](Schema::Row row) { sum += row.get<0>() + row.get<1>(); });
+    }
+    sink = sum;
+  });
+  report("scan", generic, specialized, tuples);
+
+  size_t matches = 0;
+  generic = timeRounds(rounds, [&] {
+    for (const db::Page &page : pages) {
+      matches += td.filter(page, 3, [](const db::field_t &f) { return std::get<int>(f) < 3; }).size();
+    }
+  });
+  specialized = timeRounds(rounds, [&] {
+    for (const db::Page &page : pages) {
+      matches -= Schema::filter<3>(page, [](int f) { return f < 3; }).size();
+    }
+  });
+  report("filter", generic, specialized, tuples);
+  return matches == 0 && sink >= 0 ? 0 : 1;
+}
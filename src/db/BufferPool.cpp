@@ -1,266 +1,846 @@
 #include <db/BufferPool.hpp>
+#include <db/CompressedTier.hpp>
 #include <db/Database.hpp>
+#include <db/IoScheduler.hpp>
+#include <db/PageCompression.hpp>
+#include <db/PageGuard.hpp>
+#include <db/ScanRing.hpp>
+#include <db/SharedScan.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <limits>
 #include <numeric>
 
 using namespace db;
 
-BufferPool::BufferPool()
+constexpr unsigned PAGE_BITS = 48;
+constexpr uint64_t PAGE_MASK = (uint64_t{1} << PAGE_BITS) - 1;
+
+BufferPool::BufferPool() : BufferPool(DEFAULT_NUM_PAGES * DEFAULT_PAGE_SIZE) {}
+
+BufferPool::BufferPool(size_t capacity, NumaPolicy numaPolicy)
 // TODO pa1: add initializations if needed
-{
-  freePages = DEFAULT_NUM_PAGES;
-  first = nullptr;
-  current = nullptr;
-  last = nullptr;
+    : frames(capacity, numaPolicy), descs(frames.getCapacity() / DEFAULT_PAGE_SIZE),
+      frameLatches(std::make_unique<std::shared_mutex[]>(descs.size())) {
+  first = NO_FRAME;
+  last = NO_FRAME;
+  freeDescs.resize(descs.size());
+  std::iota(freeDescs.rbegin(), freeDescs.rend(), 0);
+  table.reserve(descs.size());
+  primaryStats = {};
+  warmStartStopping = false;
+  warmStartPrefetching = false;
   // TODO pa1: additional initialization if needed
 }
 
 BufferPool::~BufferPool() {
+  if (warmStartThread.joinable()) {
+    {
+      std::lock_guard lock(warmStartMutex);
+      warmStartStopping = true;
+    }
+    warmStartCv.notify_all();
+    warmStartThread.join();
+    try {
+      dumpResidentPages(warmStartPath);
+    } catch (...) {
+    }
+  }
   // TODO pa1: flush any remaining dirty pages
-  if (freePages == DEFAULT_NUM_PAGES) {
+  std::unique_lock lock(latch);
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; i < descs.size(); i++) {
+    if (descs[i].frame != nullptr) {
+      indices.push_back(i);
+    }
+  }
+  flushAll(lock, indices);
+}
+
+const MemoryLayout &BufferPool::getMemoryLayout() const { return frames.getLayout(); }
+
+void BufferPool::enableSecondTier(size_t capacity) {
+  std::lock_guard lock(latch);
+  secondTier = std::make_unique<CompressedTier>(capacity);
+}
+
+BufferPoolStats BufferPool::getStats() const {
+  std::lock_guard lock(latch);
+  if (secondTier == nullptr) {
+    return {primaryStats, {}, 0};
+  }
+  return {primaryStats, secondTier->getStats(), secondTier->getSize()};
+}
+
+std::optional<uint64_t> BufferPool::keyOf(const PageId &pid) const {
+  auto it = fileIds.find(pid.file);
+  // such a page number was never interned, see internKey
+  if (it == fileIds.end() || pid.page > PAGE_MASK) {
+    return std::nullopt;
+  }
+  return uint64_t{it->second} << PAGE_BITS | pid.page;
+}
+
+uint64_t BufferPool::internKey(const PageId &pid) {
+  if (pid.page > PAGE_MASK) {
+    throw std::out_of_range("Page number too large for the bufferpool");
+  }
+  auto [it, inserted] = fileIds.try_emplace(pid.file, fileNames.size());
+  if (inserted) {
+    if (!freeFileIds.empty()) {
+      it->second = freeFileIds.back();
+      freeFileIds.pop_back();
+      fileNames[it->second] = pid.file;
+    } else if (fileNames.size() > UINT16_MAX) {
+      fileIds.erase(it);
+      throw std::length_error("Too many files in bufferpool");
+    } else {
+      fileNames.push_back(pid.file);
+    }
+  }
+  return uint64_t{it->second} << PAGE_BITS | pid.page;
+}
+
+PageId BufferPool::pageIdOf(const FrameDesc &desc) const {
+  return {fileNames[desc.key >> PAGE_BITS], static_cast<size_t>(desc.key & PAGE_MASK)};
+}
+
+uint32_t BufferPool::find(const PageId &pid) const {
+  std::optional<uint64_t> key = keyOf(pid);
+  if (!key) {
+    return NO_FRAME;
+  }
+  auto it = table.find(*key);
+  return it == table.end() ? NO_FRAME : it->second;
+}
+
+uint32_t BufferPool::findLoaded(std::unique_lock<std::mutex> &lock, const PageId &pid) {
+  uint32_t index = find(pid);
+  while (index != NO_FRAME && descs[index].isLoading) {
+    loaded.wait(lock);
+    // the prefetch may have failed, and the descriptor may hold another page by now
+    index = find(pid);
+  }
+  return index;
+}
+
+void BufferPool::unlink(uint32_t index) {
+  FrameDesc &desc = descs[index];
+  if (desc.prev == NO_FRAME) {
+    first = desc.next;
+  } else {
+    descs[desc.prev].next = desc.next;
+  }
+  if (desc.next == NO_FRAME) {
+    last = desc.prev;
+  } else {
+    descs[desc.next].prev = desc.prev;
+  }
+}
+
+void BufferPool::pushFront(uint32_t index) {
+  FrameDesc &desc = descs[index];
+  desc.prev = NO_FRAME;
+  desc.next = first;
+  if (first == NO_FRAME) {
+    last = index;
+  } else {
+    descs[first].prev = index;
+  }
+  first = index;
+}
+
+void BufferPool::pushBack(uint32_t index) {
+  FrameDesc &desc = descs[index];
+  desc.next = NO_FRAME;
+  desc.prev = last;
+  if (last == NO_FRAME) {
+    first = index;
   } else {
-    current = first;
+    descs[last].next = index;
+  }
+  last = index;
+}
+
+std::span<char> BufferPool::frameOf(const FrameDesc &desc) {
+  return {desc.frame, DEFAULT_PAGE_SIZE << desc.sizeClass};
+}
+
+void BufferPool::touch(uint32_t index) {
+  FrameDesc &desc = descs[index];
+  desc.isReferenced = true;
+  if (desc.ring != NO_RING) {
+    std::deque<uint32_t> &slots = rings[desc.ring - 1].slots;
+    slots.erase(std::find(slots.begin(), slots.end(), index));
+    desc.ring = NO_RING;
+    pushFront(index);
+  } else if (index != first) {
+    unlink(index);
+    pushFront(index);
+  }
+}
+
+void BufferPool::writeBack(std::unique_lock<std::mutex> &lock, uint32_t index) {
+  pin(index);
+  descs[index].isDirty = false;
+  PageId pid = pageIdOf(descs[index]);
+  std::span<char> frame = frameOf(descs[index]);
+  lock.unlock();
+  try {
+    std::shared_lock frameLock(frameLatches[index]);
     Database &db = getDatabase();
-    while (current != nullptr) {
-      if (current->isDirty) {
-        DbFile *currFile = &db.get(current->pageId.file);
-        currFile->writePage(current->page, current->pageId.page);
-        current->isDirty = false;
+    db.getIoScheduler().write(IoClass::BackgroundWrite, db.get(pid.file), frame, pid.page);
+  } catch (...) {
+    lock.lock();
+    descs[index].isDirty = true;
+    descs[index].pinCount--;
+    throw;
+  }
+  lock.lock();
+  descs[index].pinCount--;
+}
+
+void BufferPool::flushAll(std::unique_lock<std::mutex> &lock, std::vector<uint32_t> indices) {
+  std::erase_if(indices, [this](uint32_t index) { return !descs[index].isDirty; });
+  std::sort(indices.begin(), indices.end(), [this](uint32_t a, uint32_t b) { return descs[a].key < descs[b].key; });
+  std::vector<PageId> pids;
+  std::vector<std::span<char>> sources;
+  for (uint32_t index : indices) {
+    try {
+      pin(index);
+    } catch (...) {
+      for (size_t i = 0; i < pids.size(); i++) {
+        descs[indices[i]].pinCount--;
       }
-      current = current->next;
+      throw;
+    }
+    // a writer that is still holding the page marks it dirty again when it is done
+    descs[index].isDirty = false;
+    pids.push_back(pageIdOf(descs[index]));
+    sources.push_back(frameOf(descs[index]));
+  }
+  lock.unlock();
+
+  // each page is copied under its shared latch, one latch at a time, so the writes see whole pages and
+  // a thread holding guards on several of them cannot deadlock with the flush
+  Database &db = getDatabase();
+  std::vector<std::vector<char>> copies(indices.size());
+  std::vector<std::future<void>> pending;
+  for (size_t i = 0; i < indices.size(); i++) {
+    {
+      std::shared_lock frameLock(frameLatches[indices[i]]);
+      copies[i].assign(sources[i].begin(), sources[i].end());
     }
+    try {
+      pending.push_back(db.getIoScheduler().submitWrite(IoClass::BackgroundWrite, db.get(pids[i].file), copies[i],
+                                                        pids[i].page));
+    } catch (...) {
+      std::promise<void> failed;
+      failed.set_exception(std::current_exception());
+      pending.push_back(failed.get_future());
+    }
+  }
+  std::exception_ptr error;
+  std::vector<bool> written(indices.size());
+  for (size_t i = 0; i < indices.size(); i++) {
+    try {
+      pending[i].get();
+      written[i] = true;
+    } catch (...) {
+      error = error ? error : std::current_exception();
+    }
+  }
+
+  lock.lock();
+  for (size_t i = 0; i < indices.size(); i++) {
+    descs[indices[i]].isDirty = descs[indices[i]].isDirty || !written[i];
+    descs[indices[i]].pinCount--;
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void BufferPool::release(uint32_t index) {
+  FrameDesc &desc = descs[index];
+  if (desc.ring != NO_RING) {
+    std::deque<uint32_t> &slots = rings[desc.ring - 1].slots;
+    slots.erase(std::find(slots.begin(), slots.end(), index));
+  } else {
+    unlink(index);
+  }
+  table.erase(desc.key);
+  frames.release(desc.frame, DEFAULT_PAGE_SIZE << desc.sizeClass);
+  desc.frame = nullptr;
+  freeDescs.push_back(index);
+}
+
+bool BufferPool::evict(std::unique_lock<std::mutex> &lock) {
+  uint32_t victim = last;
+  while (victim != NO_FRAME && (descs[victim].pinCount > 0 || !frameLatches[victim].try_lock())) {
+    victim = descs[victim].prev;
+  }
+  if (victim == NO_FRAME) {
+    throw std::runtime_error("All pages in bufferpool are pinned");
   }
+  std::unique_lock frameLock(frameLatches[victim], std::adopt_lock);
+  if (descs[victim].isDirty) {
+    frameLock.unlock();
+    writeBack(lock, victim);
+    return false;
+  }
+  if (secondTier != nullptr) {
+    secondTier->put(descs[victim].key, frameOf(descs[victim]));
+  }
+  release(victim);
+  return true;
 }
 
 Page &BufferPool::getPage(const PageId &pid) {
+  std::span<char> page = getPageSpan(pid);
+  if (page.size() != DEFAULT_PAGE_SIZE) {
+    throw std::logic_error("Page size of file " + pid.file + " is not DEFAULT_PAGE_SIZE");
+  }
+  return *reinterpret_cast<Page *>(page.data());
+}
+
+std::span<char> BufferPool::getPageSpan(const PageId &pid) {
+  std::unique_lock lock(latch);
+  uint32_t index;
+  return fetch(lock, pid, index);
+}
+
+std::span<char> BufferPool::fetch(std::unique_lock<std::mutex> &lock, const PageId &pid, uint32_t &index) {
   // TODO pa1: If already in buffer pool, make it the most recent page and return it
 
   // TODO pa1: If there are no available pages, evict the least recently used page. If it is dirty, flush it to disk
 
   // TODO pa1: Read the page from disk to one of the available slots, make it the most recent page
 
-  if (freePages != DEFAULT_NUM_PAGES) {
-    searchPid(pid);
-  } else {
-    current = nullptr;
-  }
-  if (current != nullptr) {
-    if (current != first) {
-      if (current->next == nullptr) {
-        current->prev->next = nullptr;
-        last = current->prev;
-        first->prev = current;
-        current->prev = nullptr;
-        current->next = first;
-        first = current;
-        return first->page;
-      } else {
-        current->next->prev = current->prev;
-        current->prev->next = current->next;
-        current->prev = nullptr;
-        current->next = first;
-        first->prev = current;
-        first = current;
-        return first->page;
-      }
+  index = findLoaded(lock, pid);
+  if (index != NO_FRAME) {
+    primaryStats.hits++;
+    touch(index);
+    return frameOf(descs[index]);
+  }
+
+  Database &db = db::getDatabase();
+  DbFile *currFile = &db.get(pid.file);
+  primaryStats.misses++;
+  index = install(lock, pid, *currFile, NO_RING);
+  return frameOf(descs[index]);
+}
+
+std::span<const char> BufferPool::mappedView(const PageId &pid) const {
+  if (find(pid) != NO_FRAME) {
+    return {};
+  }
+  return getDatabase().get(pid.file).mappedPage(pid.page);
+}
+
+std::span<const char> BufferPool::viewPage(const PageId &pid) {
+  std::unique_lock lock(latch);
+  if (std::span<const char> view = mappedView(pid); !view.empty()) {
+    return view;
+  }
+  uint32_t index;
+  return fetch(lock, pid, index);
+}
+
+ReadPageGuard BufferPool::fetchRead(const PageId &pid) {
+  uint32_t index;
+  std::span<char> frame;
+  {
+    std::unique_lock lock(latch);
+    if (std::span<const char> view = mappedView(pid); !view.empty()) {
+      return {this, NO_FRAME, view};
+    }
+    frame = fetch(lock, pid, index);
+    pin(index);
+  }
+  frameLatches[index].lock_shared();
+  return {this, index, frame};
+}
+
+WritePageGuard BufferPool::fetchWrite(const PageId &pid) {
+  uint32_t index;
+  std::span<char> frame;
+  {
+    std::unique_lock lock(latch);
+    checkWritable(pid);
+    frame = fetch(lock, pid, index);
+    pin(index);
+  }
+  frameLatches[index].lock();
+  return {this, index, frame};
+}
+
+void BufferPool::pin(uint32_t index) {
+  if (descs[index].pinCount == std::numeric_limits<uint16_t>::max()) {
+    PageId pid = pageIdOf(descs[index]);
+    throw std::overflow_error("Too many pins on page " + std::to_string(pid.page) + " of " + pid.file);
+  }
+  descs[index].pinCount++;
+}
+
+void BufferPool::unpin(uint32_t index, bool dirty) {
+  std::lock_guard lock(latch);
+  descs[index].isDirty = descs[index].isDirty || dirty;
+  descs[index].pinCount--;
+}
+
+uint32_t BufferPool::install(std::unique_lock<std::mutex> &lock, const PageId &pid, const DbFile &file,
+                             uint16_t ring) {
+  size_t pageSize = file.getPageSize();
+  if (pageSize > frames.getCapacity()) {
+    throw std::logic_error("Page size of file " + pid.file + " exceeds the bufferpool capacity");
+  }
+  std::vector<char> spilled = secondTier == nullptr ? std::vector<char>{} : secondTier->take(internKey(pid));
+  char *frame = frames.allocate(pageSize);
+  bool unlocked = false;
+  while (frame == nullptr) {
+    unlocked = !evict(lock) || unlocked;
+    frame = frames.allocate(pageSize);
+  }
+  // another thread may have read the page while the latch was released for a write-back
+  if (uint32_t index = unlocked ? find(pid) : NO_FRAME; index != NO_FRAME) {
+    frames.release(frame, pageSize);
+    return index;
+  }
+  uint32_t index = adopt(pid, frame, pageSize, ring);
+
+  try {
+    if (spilled.empty()) {
+      IoClass cls = ring == NO_RING ? IoClass::ForegroundRead : IoClass::Bulk;
+      getDatabase().getIoScheduler().read(cls, file, frameOf(descs[index]), pid.page);
     } else {
-      return first->page;
+      decompressPage(spilled, frameOf(descs[index]));
     }
+  } catch (...) {
+    release(index);
+    throw;
+  }
+  return index;
+}
+
+uint32_t BufferPool::adopt(const PageId &pid, char *frame, size_t pageSize, uint16_t ring) {
+  uint64_t key = internKey(pid);
+  uint32_t index = freeDescs.back();
+  freeDescs.pop_back();
+  FrameDesc &desc = descs[index];
+  desc.key = key;
+  desc.frame = frame;
+  desc.pinCount = 0;
+  desc.ring = ring;
+  desc.sizeClass = pageSizeClass(pageSize);
+  desc.isDirty = false;
+  desc.isReferenced = false;
+  desc.isLoading = false;
+  if (ring == NO_RING) {
+    pushFront(index);
   } else {
-    Database &db = db::getDatabase();
-    if (freePages == DEFAULT_NUM_PAGES) {
-      first = new PCB;
-      first->isDirty = false;
-      first->next = nullptr;
-      first->prev = nullptr;
-      first->pageId = pid;
-      last = first;
-
-      Page *newPage = new Page;
-      DbFile *currFile = &db.get(pid.file);
-      currFile->readPage(*newPage, pid.page);
-      first->page = *newPage;
-
-      freePages--;
-      return first->page;
+    rings[ring - 1].slots.push_back(index);
+  }
+  table[key] = index;
+  return index;
+}
+
+ScanRing BufferPool::beginScan(size_t ringPages) {
+  std::lock_guard lock(latch);
+  return {this, openRing(ringPages)};
+}
+
+uint16_t BufferPool::openRing(size_t ringPages) {
+  if (ringPages == 0 || ringPages > descs.size() / 2) {
+    throw std::invalid_argument("Invalid ring size");
+  }
+  auto it = std::find_if(rings.begin(), rings.end(), [](const RingState &ring) { return !ring.active; });
+  if (it == rings.end()) {
+    if (rings.size() == UINT16_MAX) {
+      throw std::length_error("Too many scans in bufferpool");
+    }
+    it = rings.insert(it, RingState{});
+  }
+  it->capacity = ringPages;
+  it->active = true;
+  return it - rings.begin() + 1;
+}
+
+std::span<char> BufferPool::getRingPage(uint16_t ring, const PageId &pid) {
+  std::unique_lock lock(latch);
+  return frameOf(descs[ringPage(lock, ring, pid)]);
+}
+
+ReadPageGuard BufferPool::fetchRingRead(uint16_t ring, const PageId &pid) {
+  uint32_t index;
+  {
+    std::unique_lock lock(latch);
+    index = ringPage(lock, ring, pid);
+    pin(index);
+  }
+  frameLatches[index].lock_shared();
+  return {this, index, frameOf(descs[index])};
+}
+
+uint32_t BufferPool::ringPage(std::unique_lock<std::mutex> &lock, uint16_t ring, const PageId &pid) {
+  if (uint32_t index = findLoaded(lock, pid); index != NO_FRAME) {
+    primaryStats.hits++;
+    if (descs[index].ring == NO_RING) {
+      touch(index);
+    } else {
+      descs[index].isReferenced = true;
+    }
+    return index;
+  }
+
+  Database &db = db::getDatabase();
+  DbFile *currFile = &db.get(pid.file);
+  primaryStats.misses++;
+  while (rings[ring - 1].slots.size() >= rings[ring - 1].capacity) {
+    std::deque<uint32_t> &slots = rings[ring - 1].slots;
+    auto victim = std::find_if(slots.begin(), slots.end(), [this](uint32_t index) {
+      return descs[index].pinCount == 0 && frameLatches[index].try_lock();
+    });
+    if (victim == slots.end()) {
+      // every frame of the ring is pinned, so the ring grows past its capacity for now
+      break;
     }
-    if (freePages == 0) {
-      if (last->isDirty) {
-        flushPage(last->pageId);
+    uint32_t index = *victim;
+    std::unique_lock frameLock(frameLatches[index], std::adopt_lock);
+    if (!descs[index].isDirty) {
+      release(index);
+      break;
+    }
+    frameLock.unlock();
+    writeBack(lock, index);
+    if (index = find(pid); index != NO_FRAME) {
+      return index;
+    }
+  }
+  return install(lock, pid, *currFile, ring);
+}
+
+void BufferPool::endScan(uint16_t ring) {
+  std::lock_guard lock(latch);
+  closeRing(ring);
+}
+
+void BufferPool::closeRing(uint16_t ring) {
+  RingState &state = rings[ring - 1];
+  for (auto it = state.slots.rbegin(); it != state.slots.rend(); ++it) {
+    descs[*it].ring = NO_RING;
+    pushBack(*it);
+  }
+  state.slots.clear();
+  state.active = false;
+}
+
+SharedScan BufferPool::beginSharedScan(const std::string &file) {
+  std::lock_guard lock(latch);
+  size_t numPages = getDatabase().get(file).getNumPages();
+  auto it = sharedScans.find(file);
+  if (it == sharedScans.end()) {
+    it = sharedScans.emplace(file, SharedScanGroup{openRing(DEFAULT_RING_PAGES), 0, 0}).first;
+  }
+  it->second.participants++;
+  size_t start = numPages == 0 ? 0 : it->second.position % numPages;
+  return {this, file, start, numPages};
+}
+
+ReadPageGuard BufferPool::getSharedScanPage(const std::string &file, size_t page) {
+  uint32_t index;
+  {
+    std::unique_lock lock(latch);
+    SharedScanGroup &group = sharedScans.at(file);
+    group.position = page;
+    index = ringPage(lock, group.ring, {file, page});
+    pin(index);
+  }
+  frameLatches[index].lock_shared();
+  return {this, index, frameOf(descs[index])};
+}
+
+void BufferPool::endSharedScan(const std::string &file) {
+  std::lock_guard lock(latch);
+  auto it = sharedScans.find(file);
+  if (--it->second.participants == 0) {
+    closeRing(it->second.ring);
+    sharedScans.erase(it);
+  }
+}
+
+std::vector<PageId> BufferPool::getResidentPages() const {
+  std::lock_guard lock(latch);
+  std::vector<PageId> pages;
+  for (uint32_t i = first; i != NO_FRAME; i = descs[i].next) {
+    pages.push_back(pageIdOf(descs[i]));
+  }
+  return pages;
+}
+
+void BufferPool::dumpResidentPages(const std::string &path) const {
+  std::vector<PageId> pages = getResidentPages();
+  std::string tmp = path + ".tmp";
+  std::ofstream out(tmp, std::ios::trunc);
+  for (const PageId &pid : pages) {
+    out << pid.page << '\t' << pid.file << '\n';
+  }
+  out.close();
+  if (!out) {
+    throw std::runtime_error("Could not write " + tmp);
+  }
+  std::filesystem::rename(tmp, path);
+}
+
+static std::vector<PageId> readDump(const std::string &path) {
+  std::vector<PageId> pages;
+  std::ifstream in(path);
+  PageId pid;
+  while (in >> pid.page && in.get() == '\t' && std::getline(in, pid.file)) {
+    pages.push_back(pid);
+  }
+  return pages;
+}
+
+void BufferPool::enableWarmStart(const std::string &path, std::chrono::milliseconds interval) {
+  if (warmStartThread.joinable()) {
+    throw std::logic_error("Warm start is already enabled");
+  }
+  warmStartPath = path;
+  warmStartPrefetching = true;
+  warmStartThread = std::thread(&BufferPool::warmStart, this, readDump(path), interval);
+}
+
+void BufferPool::awaitWarmStart() {
+  std::unique_lock lock(warmStartMutex);
+  warmStartCv.wait(lock, [this] { return !warmStartPrefetching; });
+}
+
+void BufferPool::warmStart(std::vector<PageId> pages, std::chrono::milliseconds interval) {
+  bool full = false;
+  for (size_t begin = 0; begin < pages.size() && !full; begin += WARM_START_BATCH) {
+    auto batch = pages.begin() + begin;
+    auto end = pages.begin() + std::min(begin + WARM_START_BATCH, pages.size());
+    std::sort(batch, end, [](const PageId &a, const PageId &b) {
+      return a.file == b.file ? a.page < b.page : a.file < b.file;
+    });
+    for (; batch != end && !full; ++batch) {
+      std::lock_guard lock(warmStartMutex);
+      if (warmStartStopping) {
+        break;
       }
-      discardPage(last->pageId);
+      full = !prefetch(*batch);
     }
-    if (freePages > 0) {
-      current = new PCB;
-      current->isDirty = false;
-      current->next = first;
-      current->next->prev = current;
-      current->prev = nullptr;
-      current->pageId = pid;
-      first = current;
-
-      Page *newPage = new Page;
-      DbFile *currFile = &db.get(pid.file);
-      currFile->readPage(*newPage, pid.page);
-      first->page = *newPage;
-
-      freePages--;
-      return first->page;
-    } else {
-      throw std::logic_error("Something went wrong in get page");
+  }
+
+  std::unique_lock lock(warmStartMutex);
+  warmStartPrefetching = false;
+  warmStartCv.notify_all();
+  while (!warmStartCv.wait_for(lock, interval, [this] { return warmStartStopping; })) {
+    lock.unlock();
+    try {
+      dumpResidentPages(warmStartPath);
+    } catch (...) {
     }
+    lock.lock();
   }
 }
 
+bool BufferPool::prefetch(const PageId &pid) {
+  std::unique_lock lock(latch);
+  if (find(pid) != NO_FRAME) {
+    return true;
+  }
+  const DbFile *file;
+  try {
+    file = &getDatabase().get(pid.file);
+    if (!file->mappedPage(pid.page).empty()) {
+      return true;
+    }
+  } catch (const std::exception &) {
+    // the file was removed or the page no longer exists
+    return true;
+  }
+  size_t pageSize = file->getPageSize();
+  char *frame = frames.allocate(pageSize);
+  if (frame == nullptr) {
+    return false;
+  }
+  uint32_t index;
+  try {
+    index = adopt(pid, frame, pageSize, NO_RING);
+  } catch (...) {
+    frames.release(frame, pageSize);
+    throw;
+  }
+  if (secondTier != nullptr) {
+    secondTier->discard(descs[index].key);
+  }
+  // prefetched pages are colder than anything requested since the restart
+  unlink(index);
+  pushBack(index);
+  // the pin keeps eviction away and the flag holds up lookups until the frame is filled
+  descs[index].pinCount = 1;
+  descs[index].isLoading = true;
+  lock.unlock();
+
+  bool read = true;
+  try {
+    getDatabase().getIoScheduler().submitRead(IoClass::Prefetch, *file, {frame, pageSize}, pid.page).get();
+  } catch (const std::exception &) {
+    read = false;
+  }
+  lock.lock();
+  descs[index].pinCount--;
+  descs[index].isLoading = false;
+  if (!read) {
+    release(index);
+  }
+  loaded.notify_all();
+  return true;
+}
+
 void BufferPool::markDirty(const PageId &pid) {
   // TODO pa1: Mark the page as dirty. Note that the page must already be in the buffer pool
-  if (freePages == DEFAULT_NUM_PAGES) {
+  std::unique_lock lock(latch);
+  uint32_t index = findLoaded(lock, pid);
+  if (index == NO_FRAME) {
     throw std::logic_error("No such page in bufferpool");
-  } else {
-    searchPid(pid);
-    if (current == nullptr) {
-      throw std::logic_error("No such page in bufferpool");
-    } else {
-      current->isDirty = true;
-    }
+  }
+  checkWritable(pid);
+  descs[index].isDirty = true;
+}
+
+void BufferPool::checkWritable(const PageId &pid) const {
+  if (!getDatabase().get(pid.file).mappedPage(pid.page).empty()) {
+    throw std::logic_error("Cannot write to page of read-only file " + pid.file);
   }
 }
 
 bool BufferPool::isDirty(const PageId &pid) const {
   // TODO pa1: Return whether the page is dirty. Note that the page must already be in the buffer pool
-  if (freePages == DEFAULT_NUM_PAGES) {
+  std::lock_guard lock(latch);
+  uint32_t index = find(pid);
+  if (index == NO_FRAME) {
     throw std::logic_error("No such page in bufferpool");
-  } else {
-    searchPid(pid);
-    if (current == nullptr) {
-      throw std::logic_error("No such page in bufferpool");
-    } else {
-      return current->isDirty;
-    }
   }
+  return descs[index].isDirty;
 }
 
 bool BufferPool::contains(const PageId &pid) const {
   // TODO pa1: Return whether the page is in the buffer pool
-  if (freePages == DEFAULT_NUM_PAGES) {
-    return false;
-  } else {
-    searchPid(pid);
-    if (current == nullptr) {
-      return false;
-    } else {
-      return true;
-    }
-  }
+  std::lock_guard lock(latch);
+  return find(pid) != NO_FRAME;
 }
 
 void BufferPool::discardPage(const PageId &pid) {
   // TODO pa1: Discard the page from the buffer pool. Note that the page must already be in the buffer pool
-  if (freePages == DEFAULT_NUM_PAGES) {
+  std::unique_lock lock(latch);
+  uint32_t index = findLoaded(lock, pid);
+  if (index == NO_FRAME) {
     throw std::logic_error("No such page in bufferpool");
-  } else {
-    searchPid(pid);
-    if (current == nullptr) {
-      throw std::logic_error("No such page in bufferpool");
-    } else {
-      if (current == first) {
-        if (first->next == nullptr) {
-          free(first);
-          freePages++;
-          first = nullptr;
-          last = nullptr;
-        } else {
-          first = first->next;
-          free(current);
-          first->prev = nullptr;
-          freePages++;
-        }
-      } else {
-        if (current->next == nullptr) {
-          current->prev->next = nullptr;
-          last = current->prev;
-          free(current);
-          current = first;
-          freePages++;
-        } else {
-          current->next->prev = current->prev;
-          current->prev->next = current->next;
-          free(current);
-          current = first;
-          freePages++;
-        }
-      }
+  }
+  if (descs[index].pinCount > 0) {
+    throw std::logic_error("Cannot discard pinned page");
+  }
+  release(index);
+}
+
+void BufferPool::invalidate(const PageId &pid) {
+  std::unique_lock lock(latch);
+  findLoaded(lock, pid);
+  std::optional<uint64_t> key = keyOf(pid);
+  if (!key) {
+    return;
+  }
+  if (auto it = table.find(*key); it != table.end()) {
+    if (descs[it->second].pinCount > 0) {
+      throw std::logic_error("Cannot discard pinned page");
     }
+    release(it->second);
+  }
+  if (secondTier != nullptr) {
+    secondTier->discard(*key);
   }
 }
 
 void BufferPool::flushPage(const PageId &pid) {
   // TODO pa1: Flush the page to disk. Note that the page must already be in the buffer pool
-  if (freePages == DEFAULT_NUM_PAGES) {
+  std::unique_lock lock(latch);
+  uint32_t index = find(pid);
+  if (index == NO_FRAME) {
     throw std::logic_error("No such page in bufferpool");
-  } else {
-    searchPid(pid);
-    if (current != nullptr) {
-      if (current->isDirty) {
-        Database &db = getDatabase();
-        DbFile *currFile = &db.get(current->pageId.file);
-        currFile->writePage(current->page,current->pageId.page);
-        current->isDirty = false;
-      }
-    } else {
-      throw std::logic_error("No such page in bufferpool");
-    }
   }
+  flushAll(lock, {index});
 }
 
 void BufferPool::flushFile(const std::string &file) {
   // TODO pa1: Flush all pages of the file to disk
-  if (freePages == DEFAULT_NUM_PAGES) {
+  std::unique_lock lock(latch);
+  // the LRU list may be empty while the rings hold pages
+  if (std::none_of(descs.begin(), descs.end(), [](const FrameDesc &desc) { return desc.frame != nullptr; })) {
     throw std::logic_error("No such file in bufferpool");
-  } else {
-    current = first;
-    Database &db = getDatabase();
-    DbFile *currFile = &db.get(file);
-    while (current != nullptr) {
-      if (current->pageId.file == file && current->isDirty) {
-        currFile->writePage(current->page, current->pageId.page);
-        current->isDirty = false;
-      }
-      current = current->next;
-    }
   }
-}
-
-void BufferPool::searchPid(const PageId &pid) const {
-  current = first;
-  do {
-    if (current->pageId == pid) {
-      break;
+  auto it = fileIds.find(file);
+  if (it == fileIds.end()) {
+    return;
+  }
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; i < descs.size(); i++) {
+    if (descs[i].frame != nullptr && descs[i].key >> PAGE_BITS == it->second) {
+      indices.push_back(i);
     }
-    current = current->next;
-  } while (current != nullptr);
+  }
+  flushAll(lock, indices);
 }
 
 bool BufferPool::searchFile(const std::string &name) const {
-  current = first;
-  if (first == nullptr) {
+  std::lock_guard lock(latch);
+  auto it = fileIds.find(name);
+  if (it == fileIds.end()) {
     return false;
   }
-  do {
-    if (current->pageId.file == name) {
+  for (const FrameDesc &desc : descs) {
+    if (desc.frame != nullptr && desc.key >> PAGE_BITS == it->second) {
       return true;
     }
-    current = current->next;
-  } while (current != nullptr);
+  }
   return false;
 }
 
 void BufferPool::discardFile(const std::string &file) {
   // TODO pa1: Flush all pages of the file to disk
-    current = first;
-    while (current != nullptr) {
-      if (current->pageId.file == file) {
-        discardPage(current->pageId);
+  std::unique_lock lock(latch);
+  // a prefetch of one of the file's pages is still reading from the file
+  loaded.wait(lock, [&] {
+    return std::none_of(descs.begin(), descs.end(), [&](const FrameDesc &desc) {
+      return desc.isLoading && fileNames[desc.key >> PAGE_BITS] == file;
+    });
+  });
+  auto it = fileIds.find(file);
+  if (it == fileIds.end()) {
+    return;
+  }
+  std::vector<uint32_t> indices;
+  for (uint32_t i = 0; i < descs.size(); i++) {
+    if (descs[i].frame != nullptr && descs[i].key >> PAGE_BITS == it->second) {
+      if (descs[i].pinCount > 0) {
+        throw std::logic_error("Cannot discard pinned page");
       }
-      current = current->next;
+      indices.push_back(i);
     }
-}
\ No newline at end of file
+  }
+  // no page is released unless all of them can be
+  for (uint32_t index : indices) {
+    release(index);
+  }
+  if (secondTier != nullptr) {
+    secondTier->discardMatching(uint64_t{it->second} << PAGE_BITS, ~PAGE_MASK);
+  }
+  // nothing refers to the file id anymore
+  fileNames[it->second].clear();
+  freeFileIds.push_back(it->second);
+  fileIds.erase(it);
+}
@@ -0,0 +1,77 @@
+#include <db/BulkAppender.hpp>
+#include <db/Database.hpp>
+#include <cstdlib>
+#include <cstring>
+
+using namespace db;
+
+BulkAppender::BulkAppender(const DbFile &file, size_t batchPages)
+    : file(file), pageSize(file.getPageSize()), batchPages(batchPages), batch(0), staged(0),
+      firstPage(file.getNumPages()), appended(0), finished(false) {
+  if (batchPages == 0) {
+    throw std::invalid_argument("Invalid batch size");
+  }
+  for (char *&buffer : batches) {
+    buffer = static_cast<char *>(std::aligned_alloc(DEFAULT_PAGE_SIZE, batchPages * pageSize));
+    if (buffer == nullptr) {
+      std::free(batches[0]);
+      throw std::bad_alloc();
+    }
+  }
+}
+
+BulkAppender::~BulkAppender() {
+  if (!finished) {
+    try {
+      finish();
+    } catch (...) {
+    }
+  }
+  std::free(batches[0]);
+  std::free(batches[1]);
+}
+
+std::span<char> BulkAppender::nextPage() {
+  if (finished) {
+    throw std::logic_error("Bulk append of " + file.getName() + " is finished");
+  }
+  if (staged == batchPages) {
+    submit();
+  }
+  std::span<char> page{batches[batch] + staged * pageSize, pageSize};
+  std::memset(page.data(), 0, page.size());
+  staged++;
+  appended++;
+  return page;
+}
+
+void BulkAppender::submit() {
+  if (pending.valid()) {
+    pending.get();
+  }
+  std::span<const char> pages{batches[batch], staged * pageSize};
+  size_t id = firstPage + appended - staged;
+  pending = getDatabase().getIoScheduler().submitWrite(IoClass::Bulk, file, pages, id);
+  batch = 1 - batch;
+  staged = 0;
+}
+
+size_t BulkAppender::finish() {
+  if (finished) {
+    return firstPage;
+  }
+  finished = true;
+  if (staged > 0) {
+    submit();
+  }
+  if (pending.valid()) {
+    pending.get();
+  }
+  BufferPool &bufferPool = getDatabase().getBufferPool();
+  for (size_t i = firstPage; i < firstPage + appended; i++) {
+    bufferPool.invalidate({file.getName(), i});
+  }
+  return firstPage;
+}
+
+size_t BulkAppender::getNumAppended() const { return appended; }
@@ -0,0 +1,132 @@
+#include <db/ChecksummedDbFile.hpp>
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace db;
+
+/**
+ * Scratch space for the slots of a read, reused so that verifying a page does not allocate.
+ */
+static thread_local std::vector<char> readScratch;
+
+/**
+ * Slots read at a time when a file is opened, to find the largest LSN on disk.
+ */
+static constexpr size_t LSN_SCAN_SLOTS = 64;
+
+static size_t slotSizeOf(size_t pageSize, size_t blockSize) {
+  if (blockSize == 0) {
+    throw std::invalid_argument("Block size must not be 0");
+  }
+  return sealedSize(pageSize, blockSize);
+}
+
+ChecksummedDbFile::ChecksummedDbFile(const std::string &name, const std::string &path, size_t pageSize,
+                                     size_t blockSize)
+    : DbFile(name, pageSize), path(path), slotSize(slotSizeOf(pageSize, blockSize)), nextLsn(0) {
+  fd = open(path.c_str(), O_RDWR | O_CREAT, 0644);
+  if (fd == -1) {
+    throw std::runtime_error("Could not open " + path + " for " + name);
+  }
+  // continue from the newest write on disk, torn ones included, so that no LSN is ever reused
+  try {
+    std::vector<char> slots(LSN_SCAN_SLOTS * slotSize);
+    for (size_t id = 0, numPages = getNumPages(); id < numPages; id += LSN_SCAN_SLOTS) {
+      size_t count = std::min(LSN_SCAN_SLOTS, numPages - id);
+      readSlots({slots.data(), count * slotSize}, id);
+      for (size_t i = 0; i < count; i++) {
+        nextLsn = std::max(nextLsn.load(), slotLsn({slots.data() + i * slotSize, slotSize}));
+      }
+    }
+  } catch (...) {
+    close(fd);
+    throw;
+  }
+}
+
+ChecksummedDbFile::~ChecksummedDbFile() { close(fd); }
+
+const std::string &ChecksummedDbFile::getPath() const { return path; }
+
+size_t ChecksummedDbFile::getSlotSize() const { return slotSize; }
+
+size_t ChecksummedDbFile::getNumPages() const {
+  struct stat st {};
+  if (fstat(fd, &st) == -1) {
+    throw std::runtime_error("Could not stat " + path);
+  }
+  return std::max(DbFile::getNumPages(), (static_cast<size_t>(st.st_size) + slotSize - 1) / slotSize);
+}
+
+void ChecksummedDbFile::readSlots(std::span<char> slots, const size_t id) const {
+  size_t offset = id * slotSize;
+  size_t done = 0;
+  while (done < slots.size()) {
+    ssize_t n = pread(fd, slots.data() + done, slots.size() - done, offset + done);
+    if (n == -1) {
+      throw std::runtime_error("Could not read page " + std::to_string(id) + " of " + getName());
+    }
+    if (n == 0) {
+      std::memset(slots.data() + done, 0, slots.size() - done);
+      break;
+    }
+    done += n;
+  }
+}
+
+void ChecksummedDbFile::readPage(std::span<char> page, const size_t id) const { readPages(page, id); }
+
+void ChecksummedDbFile::readPages(std::span<char> pages, const size_t id) const {
+  const size_t pageSize = getPageSize();
+  const size_t slot = slotSize;
+  const size_t numPages = pages.size() / pageSize;
+  readScratch.resize(numPages * slot);
+  readSlots({readScratch.data(), numPages * slot}, id);
+  for (size_t i = 0; i < numPages; i++) {
+    std::span<const char> sealed{readScratch.data() + i * slot, slot};
+    switch (verifyPage(sealed)) {
+    case PageStatus::Valid:
+    case PageStatus::Empty:
+      break;
+    case PageStatus::Torn:
+      throw std::runtime_error("Torn write on page " + std::to_string(id + i) + " of " + getName());
+    case PageStatus::Corrupt:
+      throw std::runtime_error("Checksum mismatch on page " + std::to_string(id + i) + " of " + getName());
+    }
+    std::span<char> page = pages.subspan(i * pageSize, pageSize);
+    std::copy_n(sealed.begin() + CHECKSUM_HEADER_SIZE, page.size(), page.begin());
+  }
+}
+
+void ChecksummedDbFile::writePage(std::span<const char> page, const size_t id) const { writePages(page, id); }
+
+void ChecksummedDbFile::writePages(std::span<const char> pages, const size_t id) const {
+  const size_t pageSize = getPageSize();
+  const size_t slot = slotSize;
+  const size_t numPages = pages.size() / pageSize;
+  std::vector<char> slots(numPages * slot);
+  for (size_t i = 0; i < numPages; i++) {
+    sealPage(pages.subspan(i * pageSize, pageSize), ++nextLsn, {slots.data() + i * slot, slot});
+  }
+  size_t done = 0;
+  while (done < slots.size()) {
+    ssize_t n = pwrite(fd, slots.data() + done, slots.size() - done, id * slot + done);
+    if (n == -1) {
+      throw std::runtime_error("Could not write page " + std::to_string(id) + " of " + getName());
+    }
+    done += n;
+  }
+  extendTo(id + numPages);
+  for (size_t i = 0; i < numPages; i++) {
+    summarizePage(pages.subspan(i * pageSize, pageSize), id + i);
+  }
+}
+
+PageStatus ChecksummedDbFile::checkPage(const size_t id) const {
+  readScratch.resize(slotSize);
+  readSlots(readScratch, id);
+  return verifyPage(readScratch);
+}
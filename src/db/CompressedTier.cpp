@@ -0,0 +1,60 @@
+#include <db/CompressedTier.hpp>
+#include <db/PageCompression.hpp>
+
+using namespace db;
+
+CompressedTier::CompressedTier(size_t capacity) : capacity(capacity), used(0), stats{} {}
+
+void CompressedTier::put(uint64_t key, std::span<const char> page) {
+  discard(key);
+  std::vector<char> data = compressPage(page);
+  if (data.size() >= page.size() || data.size() > capacity) {
+    return;
+  }
+  while (used + data.size() > capacity) {
+    erase(entries.find(lru.back()));
+  }
+  used += data.size();
+  lru.push_front(key);
+  entries.emplace(key, Entry{std::move(data), lru.begin()});
+}
+
+std::vector<char> CompressedTier::take(uint64_t key) {
+  auto it = entries.find(key);
+  if (it == entries.end()) {
+    stats.misses++;
+    return {};
+  }
+  stats.hits++;
+  std::vector<char> data = std::move(it->second.data);
+  used -= data.size();
+  lru.erase(it->second.lru);
+  entries.erase(it);
+  return data;
+}
+
+void CompressedTier::discard(uint64_t key) {
+  if (auto it = entries.find(key); it != entries.end()) {
+    erase(it);
+  }
+}
+
+void CompressedTier::discardMatching(uint64_t key, uint64_t mask) {
+  for (auto it = entries.begin(); it != entries.end();) {
+    auto next = std::next(it);
+    if ((it->first & mask) == (key & mask)) {
+      erase(it);
+    }
+    it = next;
+  }
+}
+
+void CompressedTier::erase(std::unordered_map<uint64_t, Entry>::iterator it) {
+  used -= it->second.data.size();
+  lru.erase(it->second.lru);
+  entries.erase(it);
+}
+
+size_t CompressedTier::getSize() const { return used; }
+
+const TierStats &CompressedTier::getStats() const { return stats; }
@@ -4,6 +4,10 @@ using namespace db;
 
 BufferPool &Database::getBufferPool() { return bufferPool; }
 
+IoScheduler &Database::getIoScheduler() { return ioScheduler; }
+
+TransactionManager &Database::getTransactionManager() { return transactionManager; }
+
 Database &db::getDatabase() {
   static Database instance;
   return instance;
@@ -27,8 +31,9 @@ std::unique_ptr<DbFile> Database::remove(const std::string &name) {
   if (auto search = data.find(name); search != data.end()) {
     if (this->bufferPool.searchFile(name)) {
       this->bufferPool.flushFile(name);
-      this->bufferPool.discardFile(name);
     }
+    this->bufferPool.discardFile(name);
+    this->transactionManager.discardFile(name);
     std::unique_ptr<DbFile> tmp = std::move(search->second);
     data.erase(search);
     return tmp;
@@ -1,16 +1,87 @@
 #include <db/Database.hpp>
 #include <db/DbFile.hpp>
+#include <db/PageSummary.hpp>
+#include <algorithm>
 
 using namespace db;
 
-DbFile::DbFile(const std::string &name) : name(name) {}
+DbFile::DbFile(const std::string &name, size_t pageSize) : name(name), pageSize(pageSize), numPages(0) {
+  pageSizeClass(pageSize);
+}
+
+DbFile::~DbFile() = default;
 
 const std::string &DbFile::getName() const { return name; }
 
-void DbFile::readPage(Page &page, const size_t id) const { reads.push_back(id); }
+size_t DbFile::getPageSize() const { return pageSize; }
+
+size_t DbFile::getNumPages() const {
+  std::lock_guard lock(bookkeeping);
+  return numPages;
+}
+
+void DbFile::readPage(std::span<char>, const size_t id) const {
+  std::lock_guard lock(bookkeeping);
+  reads.push_back(id);
+}
+
+void DbFile::readPages(std::span<char> pages, const size_t id) const {
+  for (size_t i = 0; i < pages.size() / pageSize; i++) {
+    readPage(pages.subspan(i * pageSize, pageSize), id + i);
+  }
+}
+
+void DbFile::writePage(std::span<const char> page, const size_t id) const {
+  {
+    std::lock_guard lock(bookkeeping);
+    writes.push_back(id);
+    numPages = std::max(numPages, id + 1);
+  }
+  summarizePage(page, id);
+}
 
-void DbFile::writePage(const Page &page, const size_t id) const { writes.push_back(id); }
+void DbFile::writePages(std::span<const char> pages, const size_t id) const {
+  for (size_t i = 0; i < pages.size() / pageSize; i++) {
+    writePage(pages.subspan(i * pageSize, pageSize), id + i);
+  }
+}
+
+std::span<const char> DbFile::mappedPage(size_t) const { return {}; }
 
 const std::vector<size_t> &DbFile::getReads() const { return reads; }
 
 const std::vector<size_t> &DbFile::getWrites() const { return writes; }
+
+void DbFile::summarize(const TupleDesc &td, const std::vector<size_t> &zoneColumns,
+                       const std::vector<size_t> &bloomColumns) {
+  auto built = std::make_shared<PageSummary>(td, zoneColumns, bloomColumns, pageSize);
+  BufferPool &bufferPool = getDatabase().getBufferPool();
+  if (bufferPool.searchFile(name)) {
+    bufferPool.flushFile(name);
+  }
+  // writers wait in summarizePage until the summary is installed, so none of their pages is missed
+  std::lock_guard lock(summaryLatch);
+  std::vector<char> page(pageSize);
+  for (size_t id = 0; id < getNumPages(); id++) {
+    readPage(page, id);
+    built->update(page, id);
+  }
+  summary = std::move(built);
+}
+
+std::shared_ptr<const PageSummary> DbFile::getSummary() const {
+  std::lock_guard lock(summaryLatch);
+  return summary;
+}
+
+void DbFile::extendTo(const size_t pages) const {
+  std::lock_guard lock(bookkeeping);
+  numPages = std::max(numPages, pages);
+}
+
+void DbFile::summarizePage(std::span<const char> page, const size_t id) const {
+  std::lock_guard lock(summaryLatch);
+  if (summary) {
+    summary->update(page, id);
+  }
+}
@@ -0,0 +1,380 @@
+#include <db/BulkAppender.hpp>
+#include <db/Database.hpp>
+#include <db/ExternalSort.hpp>
+#include <db/IoScheduler.hpp>
+#include <db/ScanRing.hpp>
+#include <db/TempDbFile.hpp>
+#include <algorithm>
+#include <atomic>
+#include <future>
+
+using namespace db;
+
+/**
+ * Frames of the ScanRing of each run generation thread.
+ */
+static constexpr size_t RUN_RING_PAGES = 4;
+
+/**
+ * Page buffers of each run that is merged: the page being merged and the one being read ahead.
+ */
+static constexpr size_t MERGE_RUN_PAGES = 2;
+
+namespace {
+using Entry = std::pair<uint64_t, uint32_t>;
+
+/**
+ * Maps the sort column of a tuple to a 64-bit integer with the same order. CHAR keys only map their first 8 bytes,
+ * so equal prefixes are compared on the rest of the bytes.
+ */
+class SortKey {
+  type_t type;
+  size_t offset;
+
+public:
+  SortKey(const TupleDesc &td, size_t column) : type(td.getType(column)), offset(td.offsetOf(column)) {}
+
+  bool isPrefix() const { return type == CHAR; }
+
+  uint64_t prefix(const char *tuple) const {
+    const char *field = tuple + offset;
+    switch (type) {
+    case INT: {
+      int32_t value;
+      std::memcpy(&value, field, sizeof(value));
+      return static_cast<uint32_t>(value) ^ 0x80000000U;
+    }
+    case DOUBLE: {
+      uint64_t bits;
+      std::memcpy(&bits, field, sizeof(bits));
+      return bits >> 63 ? ~bits : bits | 1ULL << 63;
+    }
+    case CHAR: {
+      uint64_t prefix = 0;
+      for (size_t i = 0; i < sizeof(prefix); i++) {
+        prefix = prefix << 8 | static_cast<unsigned char>(field[i]);
+      }
+      return prefix;
+    }
+    }
+    throw std::logic_error("Unknown type");
+  }
+
+  bool less(const char *a, const char *b) const {
+    uint64_t pa = prefix(a);
+    uint64_t pb = prefix(b);
+    if (pa != pb || !isPrefix()) {
+      return pa < pb;
+    }
+    return std::memcmp(a + offset + sizeof(pa), b + offset + sizeof(pb), CHAR_SIZE - sizeof(pa)) < 0;
+  }
+};
+
+/**
+ * Sorts entries on their key with a least significant digit radix sort, one byte per pass. Passes where every key
+ * has the same byte are skipped.
+ */
+void radixSort(std::vector<Entry> &entries) {
+  std::vector<Entry> scratch(entries.size());
+  for (size_t shift = 0; shift < 64 && !entries.empty(); shift += 8) {
+    std::array<size_t, 256> offsets{};
+    for (const Entry &entry : entries) {
+      offsets[entry.first >> shift & 0xFF]++;
+    }
+    if (offsets[entries[0].first >> shift & 0xFF] == entries.size()) {
+      continue;
+    }
+    for (size_t i = 0, sum = 0; i < offsets.size(); i++) {
+      sum += std::exchange(offsets[i], sum);
+    }
+    for (const Entry &entry : entries) {
+      scratch[offsets[entry.first >> shift & 0xFF]++] = entry;
+    }
+    entries.swap(scratch);
+  }
+}
+
+/**
+ * Packs tuples into full tuple pages appended to a file.
+ */
+class PageWriter {
+  BulkAppender appender;
+  size_t length;
+  size_t capacity;
+  std::span<char> page;
+  uint32_t count;
+
+public:
+  PageWriter(const DbFile &file, size_t length)
+      : appender(file, SORT_BATCH_PAGES), length(length),
+        capacity((file.getPageSize() - TUPLE_PAGE_HEADER) / length), count(capacity) {}
+
+  void append(const char *tuple) {
+    if (count == capacity) {
+      page = appender.nextPage();
+      count = 0;
+    }
+    std::memcpy(page.data() + TUPLE_PAGE_HEADER + count * length, tuple, length);
+    setTupleCount(page, ++count);
+  }
+
+  void finish() { appender.finish(); }
+};
+
+/**
+ * Reads the tuples of a run in order, one page ahead. Runs are read straight from their file into two buffers of
+ * the reader, and the next page is queued as a Prefetch request of the IoScheduler while the current one is merged.
+ */
+class RunReader {
+  const DbFile &file;
+  const TupleDesc &td;
+  const size_t numPages;
+  const size_t length;
+  size_t nextPage;
+  std::array<std::vector<char>, MERGE_RUN_PAGES> buffers;
+  size_t buffer;
+  std::future<void> ahead;
+  std::span<const char> page;
+  size_t slot;
+  size_t count;
+
+  void fetchNext() {
+    if (nextPage < numPages) {
+      ahead = getDatabase().getIoScheduler().submitRead(IoClass::Prefetch, file, buffers[1 - buffer], nextPage++);
+    }
+  }
+
+  void loadPage() {
+    slot = 0;
+    count = 0;
+    while (count == 0 && ahead.valid()) {
+      ahead.get();
+      buffer = 1 - buffer;
+      page = buffers[buffer];
+      // the other buffer is free again once the merge has moved on to this page
+      fetchNext();
+      count = td.tupleCount(page);
+    }
+  }
+
+public:
+  RunReader(const DbFile &run, const TupleDesc &td)
+      : file(run), td(td), numPages(run.getNumPages()), length(td.getLength()), nextPage(0), buffer(0) {
+    for (std::vector<char> &pageBuffer : buffers) {
+      pageBuffer.resize(run.getPageSize());
+    }
+    fetchNext();
+    loadPage();
+  }
+
+  ~RunReader() {
+    if (ahead.valid()) {
+      ahead.wait();
+    }
+  }
+
+  bool done() const { return slot == count; }
+
+  const char *current() const { return page.data() + TUPLE_PAGE_HEADER + slot * length; }
+
+  void pop() {
+    if (++slot == count) {
+      loadPage();
+    }
+  }
+};
+
+/**
+ * A tournament tree over the current tuples of k runs that stores the loser of each match. Replacing the winner
+ * only replays the matches on its path to the root.
+ */
+template <typename Less> class LoserTree {
+  Less less;
+  size_t k;
+  std::vector<size_t> losers;
+  size_t winner;
+
+public:
+  LoserTree(size_t k, Less less) : less(less), k(k), losers(k) {
+    std::vector<size_t> winners(2 * k);
+    for (size_t i = 0; i < k; i++) {
+      winners[k + i] = i;
+    }
+    for (size_t node = k - 1; node >= 1; node--) {
+      size_t a = winners[2 * node];
+      size_t b = winners[2 * node + 1];
+      winners[node] = less(b, a) ? b : a;
+      losers[node] = less(b, a) ? a : b;
+    }
+    winner = winners[1];
+  }
+
+  size_t top() const { return winner; }
+
+  void replay() {
+    for (size_t node = (k + winner) / 2; node >= 1; node /= 2) {
+      if (less(losers[node], winner)) {
+        std::swap(losers[node], winner);
+      }
+    }
+  }
+};
+} // namespace
+
+ExternalSort::ExternalSort(const TupleDesc &td, size_t column, size_t memoryGrant, size_t threads)
+    : td(td), column(column), memoryGrant(memoryGrant), threads(threads) {
+  if (column >= td.size()) {
+    throw std::invalid_argument("No column " + std::to_string(column));
+  }
+  if (threads == 0) {
+    throw std::invalid_argument("A sort needs at least one thread");
+  }
+}
+
+SortStats ExternalSort::sort(const std::string &input, const std::string &output) const {
+  Database &db = getDatabase();
+  BufferPool &bufferPool = db.getBufferPool();
+  const DbFile &inputFile = db.get(input);
+  const size_t pageSize = inputFile.getPageSize();
+  const size_t length = td.getLength();
+  const size_t perPage = td.pageCapacity(pageSize);
+  const size_t grantPages = memoryGrant / pageSize;
+  if (grantPages < 2 * MERGE_RUN_PAGES + 2 * SORT_BATCH_PAGES) {
+    throw std::invalid_argument("Memory grant is too small to merge runs");
+  }
+  // a run thread holds its tuples and two entries per tuple for the radix sort
+  const size_t tupleCost = length + 2 * sizeof(Entry);
+  // the rings of the run threads may take up to half of the bufferpool
+  const size_t poolPages = bufferPool.getMemoryLayout().capacity / pageSize / 2;
+  const size_t runThreads = std::min({threads, memoryGrant / (perPage * tupleCost),
+                                      std::max<size_t>(1, poolPages / RUN_RING_PAGES)});
+  if (runThreads == 0) {
+    throw std::invalid_argument("Memory grant is too small to hold a page of tuples");
+  }
+  const size_t tuplesPerRun = memoryGrant / runThreads / tupleCost;
+  const size_t fanIn = std::max<size_t>(2, (grantPages - 2 * SORT_BATCH_PAGES) / MERGE_RUN_PAGES);
+  const SortKey key(td, column);
+
+  std::vector<std::unique_ptr<TempDbFile>> runs;
+  std::mutex runsMutex;
+  // the name of a run is reused once the run is merged, so a sort uses no more names than it has runs at once
+  std::vector<std::string> freeNames;
+  size_t numNames = 0;
+  auto takeName = [&] {
+    if (freeNames.empty()) {
+      return output + ".run" + std::to_string(numNames++);
+    }
+    std::string name = std::move(freeNames.back());
+    freeNames.pop_back();
+    return name;
+  };
+  std::atomic<size_t> nextPage{0};
+  const size_t numPages = inputFile.getNumPages();
+  auto generate = [&] {
+    ScanRing ring = bufferPool.beginScan(RUN_RING_PAGES);
+    std::vector<char> tuples(tuplesPerRun * length);
+    std::vector<Entry> entries;
+    entries.reserve(tuplesPerRun);
+    auto writeRun = [&] {
+      if (entries.empty()) {
+        return;
+      }
+      if (key.isPrefix()) {
+        std::sort(entries.begin(), entries.end(), [&](const Entry &a, const Entry &b) {
+          return key.less(&tuples[a.second * length], &tuples[b.second * length]);
+        });
+      } else {
+        radixSort(entries);
+      }
+      std::unique_lock lock(runsMutex);
+      auto run = std::make_unique<TempDbFile>(takeName(), pageSize);
+      lock.unlock();
+      PageWriter writer(*run, length);
+      for (const Entry &entry : entries) {
+        writer.append(&tuples[entry.second * length]);
+      }
+      writer.finish();
+      entries.clear();
+      lock.lock();
+      runs.push_back(std::move(run));
+    };
+    for (size_t id; (id = nextPage++) < numPages;) {
+      if (entries.size() + perPage > tuplesPerRun) {
+        writeRun();
+      }
+      ReadPageGuard guard = ring.fetchRead({input, id});
+      std::span<const char> page = guard.getData();
+      size_t count = td.tupleCount(page);
+      for (size_t slot = 0; slot < count; slot++) {
+        char *tuple = &tuples[entries.size() * length];
+        std::memcpy(tuple, page.data() + TUPLE_PAGE_HEADER + slot * length, length);
+        entries.emplace_back(key.prefix(tuple), static_cast<uint32_t>(entries.size()));
+      }
+    }
+    writeRun();
+  };
+  std::vector<std::future<void>> workers;
+  for (size_t i = 0; i < runThreads; i++) {
+    workers.push_back(std::async(std::launch::async, generate));
+  }
+  for (std::future<void> &worker : workers) {
+    worker.get();
+  }
+
+  SortStats stats{runs.size(), 0};
+  std::vector<std::string> names;
+  for (std::unique_ptr<TempDbFile> &run : runs) {
+    names.push_back(run->getName());
+    db.add(std::move(run));
+  }
+  std::vector<std::string> merged;
+  try {
+    while (!names.empty()) {
+      stats.mergePasses++;
+      bool last = names.size() <= fanIn;
+      for (size_t begin = 0; begin < names.size(); begin += fanIn) {
+        size_t end = std::min(begin + fanIn, names.size());
+        std::unique_ptr<TempDbFile> run;
+        if (!last) {
+          run = std::make_unique<TempDbFile>(takeName(), pageSize);
+        }
+        {
+          std::vector<std::unique_ptr<RunReader>> readers;
+          for (size_t i = begin; i < end; i++) {
+            readers.push_back(std::make_unique<RunReader>(db.get(names[i]), td));
+          }
+          LoserTree tree(readers.size(), [&](size_t a, size_t b) {
+            return !readers[a]->done() &&
+                   (readers[b]->done() || key.less(readers[a]->current(), readers[b]->current()));
+          });
+          PageWriter writer(last ? db.get(output) : *run, length);
+          for (size_t w = tree.top(); !readers[w]->done(); w = tree.top()) {
+            writer.append(readers[w]->current());
+            readers[w]->pop();
+            tree.replay();
+          }
+          writer.finish();
+        }
+        for (size_t i = begin; i < end; i++) {
+          db.remove(names[i]);
+          freeNames.push_back(std::exchange(names[i], {}));
+        }
+        if (!last) {
+          merged.push_back(run->getName());
+          db.add(std::move(run));
+        }
+      }
+      names = std::exchange(merged, {});
+    }
+  } catch (...) {
+    for (const std::vector<std::string> &pending : {names, merged}) {
+      for (const std::string &name : pending) {
+        if (!name.empty()) {
+          db.remove(name);
+        }
+      }
+    }
+    throw;
+  }
+  return stats;
+}
@@ -0,0 +1,166 @@
+#include <db/FrameAllocator.hpp>
+#include <algorithm>
+#include <fstream>
+#include <linux/mempolicy.h>
+#include <new>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace db;
+
+constexpr size_t HUGE_2M = size_t{1} << 21;
+constexpr size_t HUGE_1G = size_t{1} << 30;
+
+static size_t roundUp(size_t size, size_t alignment) { return (size + alignment - 1) / alignment * alignment; }
+
+static void *reserve(size_t size, int flags) {
+  void *addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | flags, -1, 0);
+  return addr == MAP_FAILED ? nullptr : addr;
+}
+
+/**
+ * @brief Returns the ids of the online NUMA nodes, parsed from a list such as "0-1,3".
+ */
+static std::vector<unsigned long> onlineNodes() {
+  std::vector<unsigned long> nodes;
+  std::ifstream in("/sys/devices/system/node/online");
+  std::string range;
+  while (std::getline(in, range, ',')) {
+    size_t dash = range.find('-');
+    unsigned long lo = std::stoul(range.substr(0, dash));
+    unsigned long hi = dash == std::string::npos ? lo : std::stoul(range.substr(dash + 1));
+    for (unsigned long node = lo; node <= hi; node++) {
+      nodes.push_back(node);
+    }
+  }
+  if (nodes.empty()) {
+    nodes.push_back(0);
+  }
+  return nodes;
+}
+
+static bool bind(void *addr, size_t size, int mode, const std::vector<unsigned long> &nodes) {
+  constexpr size_t bits = 8 * sizeof(unsigned long);
+  std::vector<unsigned long> mask(nodes.back() / bits + 1);
+  for (unsigned long node : nodes) {
+    mask[node / bits] |= 1UL << (node % bits);
+  }
+  return syscall(SYS_mbind, addr, size, mode, mask.data(), mask.size() * bits + 1, 0) == 0;
+}
+
+FrameAllocator::FrameAllocator(size_t capacity, NumaPolicy numaPolicy)
+    : capacity(capacity / DEFAULT_PAGE_SIZE * DEFAULT_PAGE_SIZE) {
+  layout.capacity = this->capacity;
+  region = nullptr;
+  if (this->capacity >= HUGE_1G) {
+    layout.reserved = roundUp(this->capacity, HUGE_1G);
+    layout.backing = PageBacking::Huge1G;
+    region = static_cast<char *>(reserve(layout.reserved, MAP_HUGETLB | (30 << MAP_HUGE_SHIFT)));
+  }
+  if (region == nullptr && this->capacity >= HUGE_2M) {
+    layout.reserved = roundUp(this->capacity, HUGE_2M);
+    layout.backing = PageBacking::Huge2M;
+    region = static_cast<char *>(reserve(layout.reserved, MAP_HUGETLB | (21 << MAP_HUGE_SHIFT)));
+  }
+  if (region == nullptr) {
+    layout.reserved = this->capacity;
+    layout.backing = PageBacking::Regular;
+    region = static_cast<char *>(reserve(layout.reserved, MAP_NORESERVE));
+    if (region == nullptr) {
+      throw std::bad_alloc();
+    }
+    if (this->capacity >= HUGE_2M && madvise(region, layout.reserved, MADV_HUGEPAGE) == 0) {
+      layout.backing = PageBacking::Transparent;
+    }
+  }
+
+  // the region has not been touched yet, so binding it now decides where every frame will live
+  std::vector<unsigned long> nodes = onlineNodes();
+  layout.numaNodes = nodes.size();
+  layout.numaPolicy = NumaPolicy::Local;
+  if (nodes.size() > 1 && numaPolicy == NumaPolicy::Interleave) {
+    if (bind(region, layout.reserved, MPOL_INTERLEAVE, nodes)) {
+      layout.numaPolicy = NumaPolicy::Interleave;
+    }
+  } else if (nodes.size() > 1 && numaPolicy == NumaPolicy::Partition) {
+    size_t granularity = layout.backing == PageBacking::Huge1G ? HUGE_1G
+                         : layout.backing == PageBacking::Regular ? DEFAULT_PAGE_SIZE
+                                                                  : HUGE_2M;
+    size_t slice = roundUp(layout.reserved / nodes.size(), granularity);
+    bool bound = true;
+    for (size_t i = 0; i < nodes.size() && i * slice < layout.reserved; i++) {
+      size_t length = std::min(slice, layout.reserved - i * slice);
+      bound = bind(region + i * slice, length, MPOL_BIND, {nodes[i]}) && bound;
+    }
+    if (bound) {
+      layout.numaPolicy = NumaPolicy::Partition;
+    }
+  }
+  extents[0] = this->capacity;
+}
+
+FrameAllocator::~FrameAllocator() { munmap(region, layout.reserved); }
+
+size_t FrameAllocator::getCapacity() const { return capacity; }
+
+const MemoryLayout &FrameAllocator::getLayout() const { return layout; }
+
+char *FrameAllocator::allocate(size_t size) {
+  std::vector<char *> &arena = arenas[pageSizeClass(size)];
+  if (!arena.empty()) {
+    char *frame = arena.back();
+    arena.pop_back();
+    return frame;
+  }
+  if (char *frame = carve(size)) {
+    return frame;
+  }
+  drainArenas(pageSizeClass(size));
+  return carve(size);
+}
+
+void FrameAllocator::release(char *frame, size_t size) { arenas[pageSizeClass(size)].push_back(frame); }
+
+char *FrameAllocator::carve(size_t size) {
+  for (auto it = extents.begin(); it != extents.end(); ++it) {
+    auto [offset, length] = *it;
+    if (length >= size) {
+      extents.erase(it);
+      if (length > size) {
+        extents[offset + size] = length - size;
+      }
+      return region + offset;
+    }
+  }
+  return nullptr;
+}
+
+void FrameAllocator::giveBack(size_t offset, size_t size) {
+  auto next = extents.lower_bound(offset);
+  if (next != extents.end() && offset + size == next->first) {
+    size += next->second;
+    next = extents.erase(next);
+  }
+  if (next != extents.begin()) {
+    auto prev = std::prev(next);
+    if (prev->first + prev->second == offset) {
+      prev->second += size;
+      return;
+    }
+  }
+  extents[offset] = size;
+}
+
+void FrameAllocator::drainArenas(size_t keep) {
+  for (size_t c = 0; c < NUM_PAGE_SIZE_CLASSES; c++) {
+    if (c == keep) {
+      continue;
+    }
+    for (char *frame : arenas[c]) {
+      giveBack(frame - region, DEFAULT_PAGE_SIZE << c);
+    }
+    arenas[c].clear();
+  }
+}
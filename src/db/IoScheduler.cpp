@@ -0,0 +1,253 @@
+#include <db/IoScheduler.hpp>
+#include <algorithm>
+#include <bit>
+#include <numeric>
+
+using namespace db;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Issues the requests of a batch, which cover consecutive pages in order, as one request.
+ */
+static void dispatch(const DbFile &file, bool write, std::span<const std::span<char>> parts, size_t id) {
+  if (parts.size() == 1) {
+    write ? file.writePages(parts[0], id) : file.readPages(parts[0], id);
+    return;
+  }
+  size_t size = 0;
+  for (std::span<char> part : parts) {
+    size += part.size();
+  }
+  std::vector<char> buffer(size);
+  if (write) {
+    for (size_t offset = 0; std::span<char> part : parts) {
+      std::copy(part.begin(), part.end(), buffer.begin() + offset);
+      offset += part.size();
+    }
+    file.writePages(buffer, id);
+  } else {
+    file.readPages(buffer, id);
+    for (size_t offset = 0; std::span<char> part : parts) {
+      std::copy_n(buffer.begin() + offset, part.size(), part.begin());
+      offset += part.size();
+    }
+  }
+}
+
+std::chrono::microseconds IoClassStats::percentile(double p) const {
+  size_t total = std::accumulate(histogram.begin(), histogram.end(), size_t{0});
+  size_t seen = 0;
+  for (size_t i = 0; i < histogram.size(); i++) {
+    seen += histogram[i];
+    if (seen > 0 && seen >= p * total) {
+      return std::chrono::microseconds(1ULL << i);
+    }
+  }
+  return std::chrono::microseconds(0);
+}
+
+IoScheduler::IoScheduler(const std::array<size_t, NUM_IO_CLASSES> &depths,
+                         const std::array<std::chrono::microseconds, NUM_IO_CLASSES> &deadlines)
+    : depths(depths), deadlines(deadlines), inFlight{}, stats{}, nextSeq(0), stopping(false) {
+  if (std::accumulate(depths.begin(), depths.end(), size_t{0}) == 0) {
+    throw std::invalid_argument("At least one I/O class needs a queue");
+  }
+}
+
+IoScheduler::~IoScheduler() {
+  {
+    std::lock_guard lock(latch);
+    stopping = true;
+  }
+  cv.notify_all();
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+void IoScheduler::record(IoClass cls, size_t pages, Clock::time_point submitted) {
+  auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - submitted);
+  IoClassStats &s = stats[static_cast<size_t>(cls)];
+  s.requests++;
+  s.pages += pages;
+  s.totalLatency += latency;
+  s.maxLatency = std::max(s.maxLatency, latency);
+  uint64_t micros = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+  s.histogram[std::min<size_t>(std::bit_width(micros), IO_LATENCY_BUCKETS - 1)]++;
+}
+
+void IoScheduler::read(IoClass cls, const DbFile &file, std::span<char> pages, size_t id) {
+  Clock::time_point submitted = Clock::now();
+  file.readPages(pages, id);
+  std::lock_guard lock(latch);
+  stats[static_cast<size_t>(cls)].dispatches++;
+  record(cls, pages.size() / file.getPageSize(), submitted);
+}
+
+void IoScheduler::write(IoClass cls, const DbFile &file, std::span<const char> pages, size_t id) {
+  Clock::time_point submitted = Clock::now();
+  file.writePages(pages, id);
+  std::lock_guard lock(latch);
+  stats[static_cast<size_t>(cls)].dispatches++;
+  record(cls, pages.size() / file.getPageSize(), submitted);
+}
+
+std::future<void> IoScheduler::submitRead(IoClass cls, const DbFile &file, std::span<char> pages, size_t id) {
+  return submit(cls, file, false, pages, id);
+}
+
+std::future<void> IoScheduler::submitWrite(IoClass cls, const DbFile &file, std::span<const char> pages, size_t id) {
+  // the buffer of a write is only read
+  return submit(cls, file, true, {const_cast<char *>(pages.data()), pages.size()}, id);
+}
+
+std::future<void> IoScheduler::submit(IoClass cls, const DbFile &file, bool write, std::span<char> pages, size_t id) {
+  size_t c = static_cast<size_t>(cls);
+  if (depths[c] == 0) {
+    throw std::invalid_argument("I/O class has no queue");
+  }
+  Clock::time_point now = Clock::now();
+  Request request{&file, write, id, pages, 0, now, now + deadlines[c], {}};
+  std::future<void> done = request.done.get_future();
+  {
+    std::lock_guard lock(latch);
+    request.seq = nextSeq++;
+    if (workers.empty()) {
+      for (size_t i = 0, n = std::accumulate(depths.begin(), depths.end(), size_t{0}); i < n; i++) {
+        workers.emplace_back(&IoScheduler::work, this);
+      }
+    }
+    queues[c].push_back(std::move(request));
+  }
+  cv.notify_one();
+  return done;
+}
+
+/**
+ * Returns whether two requests cover a common page of the same file.
+ */
+static bool overlaps(const DbFile *file, size_t id, size_t numPages, const DbFile *otherFile, size_t otherId,
+                     size_t otherPages) {
+  return file == otherFile && id < otherId + otherPages && otherId < id + numPages;
+}
+
+bool IoScheduler::blocked(const Request &request) const {
+  if (!request.write) {
+    return false;
+  }
+  const size_t numPages = request.pages.size() / request.file->getPageSize();
+  auto conflicts = [&](const Request &other) {
+    return other.write && overlaps(request.file, request.id, numPages, other.file, other.id,
+                                   other.pages.size() / other.file->getPageSize());
+  };
+  if (std::any_of(writing.begin(), writing.end(), [&](const Request *other) { return conflicts(*other); })) {
+    return true;
+  }
+  for (const std::deque<Request> &queue : queues) {
+    for (const Request &other : queue) {
+      if (other.seq < request.seq && conflicts(other)) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+size_t IoScheduler::pick() const {
+  size_t best = NUM_IO_CLASSES;
+  for (size_t c = 0; c < NUM_IO_CLASSES; c++) {
+    if (!queues[c].empty() && inFlight[c] < depths[c] && !blocked(queues[c].front()) &&
+        (best == NUM_IO_CLASSES || queues[c].front().deadline < queues[best].front().deadline)) {
+      best = c;
+    }
+  }
+  return best;
+}
+
+std::vector<IoScheduler::Request> IoScheduler::take(size_t cls) {
+  std::deque<Request> &queue = queues[cls];
+  std::vector<Request> batch;
+  batch.push_back(std::move(queue.front()));
+  queue.pop_front();
+  const DbFile *file = batch.front().file;
+  const bool write = batch.front().write;
+  const size_t pageSize = file->getPageSize();
+  size_t low = batch.front().id;
+  size_t high = low + batch.front().pages.size() / pageSize;
+  for (bool grown = true; grown;) {
+    grown = false;
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+      size_t numPages = it->pages.size() / pageSize;
+      if (it->file != file || it->write != write || high - low + numPages > MAX_IO_MERGE_PAGES ||
+          (it->id != high && it->id + numPages != low) || blocked(*it)) {
+        continue;
+      }
+      if (it->id == high) {
+        high += numPages;
+      } else {
+        low -= numPages;
+      }
+      batch.push_back(std::move(*it));
+      queue.erase(it);
+      grown = true;
+      break;
+    }
+  }
+  std::sort(batch.begin(), batch.end(), [](const Request &a, const Request &b) { return a.id < b.id; });
+  return batch;
+}
+
+void IoScheduler::work() {
+  std::unique_lock lock(latch);
+  while (true) {
+    cv.wait(lock, [this] {
+      return pick() != NUM_IO_CLASSES ||
+             (stopping && std::all_of(queues.begin(), queues.end(), [](const auto &q) { return q.empty(); }));
+    });
+    size_t cls = pick();
+    if (cls == NUM_IO_CLASSES) {
+      return;
+    }
+    std::vector<Request> batch = take(cls);
+    inFlight[cls]++;
+    if (batch.front().write) {
+      for (const Request &request : batch) {
+        writing.push_back(&request);
+      }
+    }
+    lock.unlock();
+
+    std::vector<std::span<char>> parts;
+    for (const Request &request : batch) {
+      parts.push_back(request.pages);
+    }
+    std::exception_ptr error;
+    try {
+      dispatch(*batch.front().file, batch.front().write, parts, batch.front().id);
+    } catch (...) {
+      error = std::current_exception();
+    }
+
+    lock.lock();
+    inFlight[cls]--;
+    std::erase_if(writing, [&](const Request *request) {
+      return request >= batch.data() && request < batch.data() + batch.size();
+    });
+    stats[cls].dispatches++;
+    for (const Request &request : batch) {
+      record(static_cast<IoClass>(cls), request.pages.size() / request.file->getPageSize(), request.submitted);
+    }
+    lock.unlock();
+    cv.notify_all();
+    for (Request &request : batch) {
+      error ? request.done.set_exception(error) : request.done.set_value();
+    }
+    lock.lock();
+  }
+}
+
+IoClassStats IoScheduler::getStats(IoClass cls) const {
+  std::lock_guard lock(latch);
+  return stats[static_cast<size_t>(cls)];
+}
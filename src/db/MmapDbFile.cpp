@@ -0,0 +1,75 @@
+#include <db/MmapDbFile.hpp>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace db;
+
+static int toAdvice(MmapDbFile::Access access) {
+  switch (access) {
+  case MmapDbFile::Access::Sequential:
+    return MADV_SEQUENTIAL;
+  case MmapDbFile::Access::Random:
+    return MADV_RANDOM;
+  case MmapDbFile::Access::WillNeed:
+    return MADV_WILLNEED;
+  default:
+    return MADV_NORMAL;
+  }
+}
+
+MmapDbFile::MmapDbFile(const std::string &name, Access access, size_t pageSize)
+    : DbFile(name, pageSize), data(nullptr), numPages(0) {
+  fd = open(name.c_str(), O_RDONLY);
+  if (fd == -1) {
+    throw std::runtime_error("Could not open file " + name);
+  }
+  struct stat st {};
+  if (fstat(fd, &st) == -1) {
+    close(fd);
+    throw std::runtime_error("Could not stat file " + name);
+  }
+  numPages = st.st_size / getPageSize();
+  if (numPages > 0) {
+    void *addr = mmap(nullptr, numPages * getPageSize(), PROT_READ, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+      close(fd);
+      throw std::runtime_error("Could not map file " + name);
+    }
+    data = static_cast<char *>(addr);
+    advise(access);
+  }
+}
+
+MmapDbFile::~MmapDbFile() {
+  if (data != nullptr) {
+    munmap(data, numPages * getPageSize());
+  }
+  close(fd);
+}
+
+void MmapDbFile::advise(Access access) const {
+  if (data != nullptr) {
+    madvise(data, numPages * getPageSize(), toAdvice(access));
+  }
+}
+
+size_t MmapDbFile::getNumPages() const { return numPages; }
+
+void MmapDbFile::readPage(std::span<char> page, const size_t id) const {
+  std::memcpy(page.data(), mappedPage(id).data(), page.size());
+}
+
+void MmapDbFile::writePage(std::span<const char>, size_t) const {
+  throw std::logic_error("Cannot write to read-only file " + getName());
+}
+
+std::span<const char> MmapDbFile::mappedPage(const size_t id) const {
+  if (id >= numPages) {
+    throw std::out_of_range("No such page in file " + getName());
+  }
+  return {data + id * getPageSize(), getPageSize()};
+}
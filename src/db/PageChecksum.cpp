@@ -0,0 +1,118 @@
+#include <db/PageChecksum.hpp>
+#include <algorithm>
+#include <cstring>
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
+
+using namespace db;
+
+/**
+ * Reflected CRC32C polynomial.
+ */
+static constexpr uint32_t CRC32C_POLY = 0x82F63B78U;
+
+static constexpr std::array<uint32_t, 256> CRC32C_TABLE = [] {
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < table.size(); i++) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = crc & 1 ? crc >> 1 ^ CRC32C_POLY : crc >> 1;
+    }
+    table[i] = crc;
+  }
+  return table;
+}();
+
+static uint32_t crc32cScalar(const char *data, size_t size, uint32_t crc) {
+  for (size_t i = 0; i < size; i++) {
+    crc = CRC32C_TABLE[(crc ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ crc >> 8;
+  }
+  return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) static uint32_t crc32cHardware(const char *data, size_t size, uint32_t crc) {
+  uint64_t crc64 = crc;
+  for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+    uint64_t word;
+    std::memcpy(&word, data, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+  crc = static_cast<uint32_t>(crc64);
+  for (; size > 0; data++, size--) {
+    crc = _mm_crc32_u8(crc, static_cast<unsigned char>(*data));
+  }
+  return crc;
+}
+
+static uint32_t (*const crc32cImpl)(const char *, size_t, uint32_t) = [] {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sse4.2") ? crc32cHardware : crc32cScalar;
+}();
+#else
+static uint32_t (*const crc32cImpl)(const char *, size_t, uint32_t) = crc32cScalar;
+#endif
+
+static void storeLsn(char *out, uint64_t lsn) {
+  for (size_t i = 0; i < sizeof(lsn); i++) {
+    out[i] = static_cast<char>(lsn >> 8 * i);
+  }
+}
+
+static uint64_t loadLsn(const char *in) {
+  uint64_t lsn = 0;
+  for (size_t i = 0; i < sizeof(lsn); i++) {
+    lsn |= uint64_t{static_cast<unsigned char>(in[i])} << 8 * i;
+  }
+  return lsn;
+}
+
+uint32_t db::crc32c(std::span<const char> data, uint32_t crc) {
+  return ~crc32cImpl(data.data(), data.size(), ~crc);
+}
+
+void db::sealPage(std::span<const char> page, uint64_t lsn, std::span<char> slot) {
+  if (lsn == 0) {
+    throw std::invalid_argument("LSN 0 is reserved for pages that were never written");
+  }
+  if (slot.size() < CHECKSUM_HEADER_SIZE + page.size() + CHECKSUM_TRAILER_SIZE) {
+    throw std::invalid_argument("Slot does not fit the page");
+  }
+  char *trailer = slot.data() + slot.size() - CHECKSUM_TRAILER_SIZE;
+  storeLsn(slot.data(), lsn);
+  auto padding = std::copy(page.begin(), page.end(), slot.begin() + CHECKSUM_HEADER_SIZE);
+  std::fill(padding, slot.end() - CHECKSUM_TRAILER_SIZE, 0);
+  storeLsn(trailer, lsn);
+  uint32_t crc = crc32c(slot.first(slot.size() - sizeof(crc)));
+  for (size_t i = 0; i < sizeof(crc); i++) {
+    trailer[sizeof(lsn) + i] = static_cast<char>(crc >> 8 * i);
+  }
+}
+
+uint64_t db::slotLsn(std::span<const char> slot) {
+  if (slot.size() < CHECKSUM_HEADER_SIZE + CHECKSUM_TRAILER_SIZE) {
+    throw std::invalid_argument("Slot is too small to hold a sealed page");
+  }
+  return std::max(loadLsn(slot.data()), loadLsn(slot.data() + slot.size() - CHECKSUM_TRAILER_SIZE));
+}
+
+PageStatus db::verifyPage(std::span<const char> slot) {
+  if (slot.size() < CHECKSUM_HEADER_SIZE + CHECKSUM_TRAILER_SIZE) {
+    throw std::invalid_argument("Slot is too small to hold a sealed page");
+  }
+  const char *trailer = slot.data() + slot.size() - CHECKSUM_TRAILER_SIZE;
+  uint64_t headerLsn = loadLsn(slot.data());
+  uint64_t trailerLsn = loadLsn(trailer);
+  uint32_t stored = 0;
+  for (size_t i = 0; i < sizeof(stored); i++) {
+    stored |= uint32_t{static_cast<unsigned char>(trailer[sizeof(uint64_t) + i])} << 8 * i;
+  }
+  if (crc32c(slot.first(slot.size() - sizeof(stored))) == stored) {
+    return headerLsn == trailerLsn ? PageStatus::Valid : PageStatus::Corrupt;
+  }
+  if (headerLsn == 0 && std::all_of(slot.begin(), slot.end(), [](char c) { return c == 0; })) {
+    return PageStatus::Empty;
+  }
+  return headerLsn != trailerLsn ? PageStatus::Torn : PageStatus::Corrupt;
+}
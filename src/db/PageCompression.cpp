@@ -0,0 +1,90 @@
+#include <db/PageCompression.hpp>
+#include <cstring>
+
+using namespace db;
+
+constexpr size_t MIN_MATCH = 4;
+constexpr size_t MAX_MATCH = MIN_MATCH + 0x7F;
+constexpr size_t MAX_LITERALS = 0x80;
+constexpr unsigned HASH_BITS = 12;
+
+static uint32_t hash4(const char *p) {
+  uint32_t v;
+  std::memcpy(&v, p, sizeof(v));
+  return (v * 2654435761U) >> (32 - HASH_BITS);
+}
+
+static void emitLiterals(std::vector<char> &out, const char *begin, const char *end) {
+  while (begin < end) {
+    size_t length = std::min<size_t>(end - begin, MAX_LITERALS);
+    out.push_back(static_cast<char>(length - 1));
+    out.insert(out.end(), begin, begin + length);
+    begin += length;
+  }
+}
+
+std::vector<char> db::compressPage(std::span<const char> page) {
+  std::vector<char> out;
+  out.reserve(page.size() / 4);
+  std::array<uint32_t, 1 << HASH_BITS> table{};
+  const char *base = page.data();
+  const char *end = base + page.size();
+  const char *literals = base;
+  const char *p = base;
+  while (p + MIN_MATCH <= end) {
+    uint32_t h = hash4(p);
+    const char *candidate = base + table[h];
+    table[h] = p - base;
+    if (candidate < p && std::memcmp(candidate, p, MIN_MATCH) == 0) {
+      size_t length = MIN_MATCH;
+      while (length < MAX_MATCH && p + length < end && candidate[length] == p[length]) {
+        length++;
+      }
+      emitLiterals(out, literals, p);
+      size_t distance = p - candidate;
+      out.push_back(static_cast<char>(0x80 | (length - MIN_MATCH)));
+      out.push_back(static_cast<char>(distance & 0xFF));
+      out.push_back(static_cast<char>(distance >> 8));
+      p += length;
+      literals = p;
+    } else {
+      p++;
+    }
+  }
+  emitLiterals(out, literals, end);
+  return out;
+}
+
+void db::decompressPage(std::span<const char> compressed, std::span<char> page) {
+  size_t in = 0;
+  size_t out = 0;
+  while (in < compressed.size()) {
+    auto token = static_cast<unsigned char>(compressed[in++]);
+    if (token < MAX_LITERALS) {
+      size_t length = token + 1;
+      if (in + length > compressed.size() || out + length > page.size()) {
+        throw std::runtime_error("Corrupt compressed page");
+      }
+      std::memcpy(page.data() + out, compressed.data() + in, length);
+      in += length;
+      out += length;
+    } else {
+      size_t length = (token & 0x7F) + MIN_MATCH;
+      if (in + 2 > compressed.size()) {
+        throw std::runtime_error("Corrupt compressed page");
+      }
+      size_t distance = static_cast<unsigned char>(compressed[in]) | static_cast<unsigned char>(compressed[in + 1]) << 8;
+      in += 2;
+      if (distance == 0 || distance > out || out + length > page.size()) {
+        throw std::runtime_error("Corrupt compressed page");
+      }
+      // the source may overlap the destination, so copy byte by byte
+      for (size_t i = 0; i < length; i++, out++) {
+        page[out] = page[out - distance];
+      }
+    }
+  }
+  if (out != page.size()) {
+    throw std::runtime_error("Corrupt compressed page");
+  }
+}
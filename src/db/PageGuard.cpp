@@ -0,0 +1,94 @@
+#include <db/PageGuard.hpp>
+
+using namespace db;
+
+static void checkPageSize(size_t size) {
+  if (size != DEFAULT_PAGE_SIZE) {
+    throw std::logic_error("Page size is not DEFAULT_PAGE_SIZE");
+  }
+}
+
+ReadPageGuard::ReadPageGuard(BufferPool *pool, uint32_t index, std::span<const char> frame)
+    : pool(pool), index(index), frame(frame) {}
+
+ReadPageGuard::ReadPageGuard() : pool(nullptr), index(BufferPool::NO_FRAME) {}
+
+ReadPageGuard::ReadPageGuard(ReadPageGuard &&other) noexcept
+    : pool(other.pool), index(other.index), frame(other.frame) {
+  other.pool = nullptr;
+  other.frame = {};
+}
+
+ReadPageGuard &ReadPageGuard::operator=(ReadPageGuard &&other) noexcept {
+  if (this != &other) {
+    release();
+    pool = other.pool;
+    index = other.index;
+    frame = other.frame;
+    other.pool = nullptr;
+    other.frame = {};
+  }
+  return *this;
+}
+
+ReadPageGuard::~ReadPageGuard() { release(); }
+
+std::span<const char> ReadPageGuard::getData() const { return frame; }
+
+const Page &ReadPageGuard::getPage() const {
+  checkPageSize(frame.size());
+  return *reinterpret_cast<const Page *>(frame.data());
+}
+
+void ReadPageGuard::release() {
+  if (pool == nullptr) {
+    return;
+  }
+  // pages of mapped files have no frame in the pool and are never pinned
+  if (index != BufferPool::NO_FRAME) {
+    pool->frameLatches[index].unlock_shared();
+    pool->unpin(index, false);
+  }
+  pool = nullptr;
+  frame = {};
+}
+
+WritePageGuard::WritePageGuard(BufferPool *pool, uint32_t index, std::span<char> frame)
+    : pool(pool), index(index), frame(frame) {}
+
+WritePageGuard::WritePageGuard(WritePageGuard &&other) noexcept
+    : pool(other.pool), index(other.index), frame(other.frame) {
+  other.pool = nullptr;
+  other.frame = {};
+}
+
+WritePageGuard &WritePageGuard::operator=(WritePageGuard &&other) noexcept {
+  if (this != &other) {
+    release();
+    pool = other.pool;
+    index = other.index;
+    frame = other.frame;
+    other.pool = nullptr;
+    other.frame = {};
+  }
+  return *this;
+}
+
+WritePageGuard::~WritePageGuard() { release(); }
+
+std::span<char> WritePageGuard::getData() const { return frame; }
+
+Page &WritePageGuard::getPage() const {
+  checkPageSize(frame.size());
+  return *reinterpret_cast<Page *>(frame.data());
+}
+
+void WritePageGuard::release() {
+  if (pool == nullptr) {
+    return;
+  }
+  pool->frameLatches[index].unlock();
+  pool->unpin(index, true);
+  pool = nullptr;
+  frame = {};
+}
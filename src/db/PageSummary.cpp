@@ -0,0 +1,196 @@
+#include <db/PageSummary.hpp>
+#include <algorithm>
+#include <limits>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+using namespace db;
+
+static constexpr size_t BLOOM_BLOCK_BITS = BLOOM_BLOCK_WORDS * 32;
+
+alignas(32) static constexpr uint32_t SALT[BLOOM_BLOCK_WORDS] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU,
+                                                                  0xa2b7289dU, 0x705495c7U, 0x2df1424bU,
+                                                                  0x9efc4947U, 0x5c6bfb31U};
+
+static uint64_t hashBytes(const char *data, size_t size) {
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  for (size_t i = 0; i < size; i++) {
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+  }
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+static size_t fieldSize(type_t type) {
+  switch (type) {
+  case INT:
+    return INT_SIZE;
+  case DOUBLE:
+    return DOUBLE_SIZE;
+  case CHAR:
+    return CHAR_SIZE;
+  }
+  throw std::logic_error("Unknown type");
+}
+
+static double numeric(const field_t &value) {
+  return value.index() == INT ? std::get<int>(value) : std::get<double>(value);
+}
+
+static void insertKey(uint32_t *block, uint32_t key) {
+  for (size_t i = 0; i < BLOOM_BLOCK_WORDS; i++) {
+    block[i] |= 1U << ((key * SALT[i]) >> 27);
+  }
+}
+
+static bool checkKeyScalar(const uint32_t *block, uint32_t key) {
+  for (size_t i = 0; i < BLOOM_BLOCK_WORDS; i++) {
+    if (!(block[i] & (1U << ((key * SALT[i]) >> 27)))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("avx2"))) static bool checkKeyAvx2(const uint32_t *block, uint32_t key) {
+  __m256i salt = _mm256_load_si256(reinterpret_cast<const __m256i *>(SALT));
+  __m256i shifts = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(key)), salt), 27);
+  __m256i mask = _mm256_sllv_epi32(_mm256_set1_epi32(1), shifts);
+  __m256i bits = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+  // every bit of the mask is set in the block
+  return _mm256_testc_si256(bits, mask);
+}
+
+static bool (*const checkKey)(const uint32_t *, uint32_t) = [] {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") ? checkKeyAvx2 : checkKeyScalar;
+}();
+#else
+static bool (*const checkKey)(const uint32_t *, uint32_t) = checkKeyScalar;
+#endif
+
+PageSummary::PageSummary(const TupleDesc &td, const std::vector<size_t> &zoneColumns,
+                         const std::vector<size_t> &bloomColumns, size_t pageSize, size_t bitsPerKey)
+    : td(td), zoneColumns(zoneColumns), bloomColumns(bloomColumns),
+      bloomBlocks(std::max<size_t>(1, (td.pageCapacity(pageSize) * bitsPerKey + BLOOM_BLOCK_BITS - 1) /
+                                          BLOOM_BLOCK_BITS)),
+      numPages(0), zones(zoneColumns.size()), blooms(bloomColumns.size()) {
+  if (bitsPerKey == 0) {
+    throw std::invalid_argument("A Bloom filter needs at least one bit per key");
+  }
+  for (size_t column : zoneColumns) {
+    if (column >= td.size() || td.getType(column) == CHAR) {
+      throw std::invalid_argument("No zone map for column " + std::to_string(column));
+    }
+  }
+  for (size_t column : bloomColumns) {
+    if (column >= td.size()) {
+      throw std::invalid_argument("No Bloom filter for column " + std::to_string(column));
+    }
+  }
+}
+
+const TupleDesc &PageSummary::getTupleDesc() const { return td; }
+
+size_t PageSummary::getNumPages() const {
+  std::lock_guard lock(latch);
+  return numPages;
+}
+
+void PageSummary::update(std::span<const char> page, size_t id) {
+  std::lock_guard lock(latch);
+  if (id >= numPages) {
+    numPages = id + 1;
+    for (std::vector<Zone> &zone : zones) {
+      zone.resize(numPages);
+    }
+    for (std::vector<uint32_t> &bloom : blooms) {
+      bloom.resize(numPages * bloomBlocks * BLOOM_BLOCK_WORDS);
+    }
+  }
+  for (std::vector<Zone> &zone : zones) {
+    zone[id] = {std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity()};
+  }
+  for (std::vector<uint32_t> &bloom : blooms) {
+    std::fill_n(bloom.begin() + id * bloomBlocks * BLOOM_BLOCK_WORDS, bloomBlocks * BLOOM_BLOCK_WORDS, 0);
+  }
+
+  size_t count = td.tupleCount(page);
+  const char *data = page.data() + TUPLE_PAGE_HEADER;
+  for (size_t slot = 0; slot < count; slot++, data += td.getLength()) {
+    for (size_t i = 0; i < zoneColumns.size(); i++) {
+      double value = numeric(td.getField(data, zoneColumns[i]));
+      zones[i][id].min = std::min(zones[i][id].min, value);
+      zones[i][id].max = std::max(zones[i][id].max, value);
+    }
+    for (size_t i = 0; i < bloomColumns.size(); i++) {
+      size_t column = bloomColumns[i];
+      uint64_t hash = hashBytes(data + td.offsetOf(column), fieldSize(td.getType(column)));
+      size_t block = ((hash >> 32) * bloomBlocks) >> 32;
+      insertKey(&blooms[i][(id * bloomBlocks + block) * BLOOM_BLOCK_WORDS], static_cast<uint32_t>(hash));
+    }
+  }
+}
+
+std::vector<size_t> PageSummary::candidatePages(size_t column, double low, double high) const {
+  auto zone = std::find(zoneColumns.begin(), zoneColumns.end(), column);
+  if (zone == zoneColumns.end()) {
+    throw std::invalid_argument("No zone map for column " + std::to_string(column));
+  }
+  std::lock_guard lock(latch);
+  std::vector<size_t> pages;
+  for (size_t id = 0; const Zone &z : zones[zone - zoneColumns.begin()]) {
+    if (z.min <= high && z.max >= low) {
+      pages.push_back(id);
+    }
+    id++;
+  }
+  return pages;
+}
+
+std::vector<size_t> PageSummary::candidatePages(size_t column, const field_t &value) const {
+  auto zone = std::find(zoneColumns.begin(), zoneColumns.end(), column);
+  auto bloom = std::find(bloomColumns.begin(), bloomColumns.end(), column);
+  if (zone == zoneColumns.end() && bloom == bloomColumns.end()) {
+    throw std::invalid_argument("No zone map or Bloom filter for column " + std::to_string(column));
+  }
+  if (value.index() != td.getType(column)) {
+    throw std::invalid_argument("Value is not of the type of column " + std::to_string(column));
+  }
+
+  std::array<char, CHAR_SIZE> bytes{};
+  std::visit(
+      [&](const auto &v) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(v)>, std::string>) {
+          std::copy_n(v.data(), std::min(v.size(), CHAR_SIZE), bytes.begin());
+        } else {
+          std::memcpy(bytes.data(), &v, sizeof(v));
+        }
+      },
+      value);
+  uint64_t hash = hashBytes(bytes.data(), fieldSize(td.getType(column)));
+  size_t block = ((hash >> 32) * bloomBlocks) >> 32;
+
+  std::lock_guard lock(latch);
+  std::vector<size_t> pages;
+  for (size_t id = 0; id < numPages; id++) {
+    if (zone != zoneColumns.end()) {
+      const Zone &z = zones[zone - zoneColumns.begin()][id];
+      if (numeric(value) < z.min || numeric(value) > z.max) {
+        continue;
+      }
+    }
+    if (bloom != bloomColumns.end()) {
+      const uint32_t *words = &blooms[bloom - bloomColumns.begin()][(id * bloomBlocks + block) * BLOOM_BLOCK_WORDS];
+      if (!checkKey(words, static_cast<uint32_t>(hash))) {
+        continue;
+      }
+    }
+    pages.push_back(id);
+  }
+  return pages;
+}
@@ -0,0 +1,56 @@
+#include <db/Database.hpp>
+#include <db/PageSummary.hpp>
+#include <db/ScanRing.hpp>
+#include <numeric>
+
+using namespace db;
+
+ScanRing::ScanRing(BufferPool *pool, uint16_t id) : pool(pool), id(id) {}
+
+ScanRing::ScanRing(ScanRing &&other) noexcept : pool(other.pool), id(other.id) { other.pool = nullptr; }
+
+ScanRing &ScanRing::operator=(ScanRing &&other) noexcept {
+  if (this != &other) {
+    if (pool != nullptr) {
+      pool->endScan(id);
+    }
+    pool = other.pool;
+    id = other.id;
+    other.pool = nullptr;
+  }
+  return *this;
+}
+
+ScanRing::~ScanRing() {
+  if (pool != nullptr) {
+    pool->endScan(id);
+  }
+}
+
+Page &ScanRing::getPage(const PageId &pid) {
+  std::span<char> page = getPageSpan(pid);
+  if (page.size() != DEFAULT_PAGE_SIZE) {
+    throw std::logic_error("Page size of file " + pid.file + " is not DEFAULT_PAGE_SIZE");
+  }
+  return *reinterpret_cast<Page *>(page.data());
+}
+
+std::span<char> ScanRing::getPageSpan(const PageId &pid) { return pool->getRingPage(id, pid); }
+
+ReadPageGuard ScanRing::fetchRead(const PageId &pid) { return pool->fetchRingRead(id, pid); }
+
+void ScanRing::scanMatching(const std::string &file, size_t column, const field_t &value,
+                            const std::function<void(size_t, std::span<const char>)> &visit) {
+  const DbFile &dbFile = getDatabase().get(file);
+  std::vector<size_t> pages;
+  if (std::shared_ptr<const PageSummary> summary = dbFile.getSummary()) {
+    pages = summary->candidatePages(column, value);
+  } else {
+    pages.resize(dbFile.getNumPages());
+    std::iota(pages.begin(), pages.end(), size_t{0});
+  }
+  for (size_t page : pages) {
+    ReadPageGuard guard = fetchRead({file, page});
+    visit(page, guard.getData());
+  }
+}
@@ -0,0 +1,105 @@
+#include <db/Scrubber.hpp>
+
+#include <optional>
+
+using namespace db;
+
+/**
+ * Shortest wait before a page that failed is checked again, long enough for a write in progress to complete.
+ */
+static constexpr std::chrono::microseconds RETRY_PAUSE = std::chrono::milliseconds(1);
+
+/**
+ * Checks a page, or returns nothing if it could not be read at all.
+ */
+static std::optional<PageStatus> check(const ChecksummedDbFile &file, size_t id) {
+  try {
+    return file.checkPage(id);
+  } catch (const std::exception &) {
+    return std::nullopt;
+  }
+}
+
+Scrubber::Scrubber(std::vector<const ChecksummedDbFile *> files, std::chrono::microseconds pause,
+                   std::chrono::milliseconds interval)
+    : files(std::move(files)), pause(pause), interval(interval), stats{}, stopping(false) {
+  thread = std::thread(&Scrubber::run, this);
+}
+
+Scrubber::~Scrubber() {
+  {
+    std::lock_guard lock(mutex);
+    stopping = true;
+  }
+  cv.notify_all();
+  thread.join();
+}
+
+ScrubStats Scrubber::getStats() const {
+  std::lock_guard lock(mutex);
+  return stats;
+}
+
+std::vector<BadPage> Scrubber::getBadPages() const {
+  std::lock_guard lock(mutex);
+  return badPages;
+}
+
+std::vector<PageId> Scrubber::getUnreadablePages() const {
+  std::lock_guard lock(mutex);
+  return unreadablePages;
+}
+
+void Scrubber::awaitPasses(size_t passes) {
+  std::unique_lock lock(mutex);
+  cv.wait(lock, [&] { return stats.passes >= passes; });
+}
+
+bool Scrubber::sleep(std::unique_lock<std::mutex> &lock, std::chrono::microseconds duration) {
+  if (duration.count() == 0) {
+    return stopping;
+  }
+  return cv.wait_for(lock, duration, [this] { return stopping; });
+}
+
+void Scrubber::run() {
+  std::unique_lock lock(mutex);
+  while (!stopping) {
+    std::vector<BadPage> found;
+    std::vector<PageId> unreadable;
+    for (const ChecksummedDbFile *file : files) {
+      for (size_t id = 0; id < file->getNumPages(); id++) {
+        lock.unlock();
+        std::optional<PageStatus> status = check(*file, id);
+        lock.lock();
+        if (status != PageStatus::Valid && status != PageStatus::Empty) {
+          // a write of the page may have been in progress, check it again once it is done
+          if (sleep(lock, std::max(pause, RETRY_PAUSE))) {
+            return;
+          }
+          lock.unlock();
+          status = check(*file, id);
+          lock.lock();
+        }
+        stats.pages++;
+        if (!status) {
+          stats.unreadable++;
+          unreadable.push_back({file->getName(), id});
+        } else if (status == PageStatus::Torn || status == PageStatus::Corrupt) {
+          (status == PageStatus::Torn ? stats.torn : stats.corrupt)++;
+          found.push_back({file->getName(), id, *status});
+        }
+        if (sleep(lock, pause)) {
+          return;
+        }
+      }
+    }
+    badPages = std::move(found);
+    unreadablePages = std::move(unreadable);
+    stats.passes++;
+    cv.notify_all();
+    if (sleep(lock, interval)) {
+      return;
+    }
+  }
+}
@@ -0,0 +1,46 @@
+#include <db/SharedScan.hpp>
+
+using namespace db;
+
+SharedScan::SharedScan(BufferPool *pool, const std::string &file, size_t start, size_t numPages)
+    : pool(pool), file(file), start(start), numPages(numPages), visited(0) {}
+
+SharedScan::SharedScan(SharedScan &&other) noexcept
+    : pool(other.pool), file(std::move(other.file)), start(other.start), numPages(other.numPages),
+      visited(other.visited) {
+  other.pool = nullptr;
+}
+
+SharedScan &SharedScan::operator=(SharedScan &&other) noexcept {
+  if (this != &other) {
+    if (pool != nullptr) {
+      pool->endSharedScan(file);
+    }
+    pool = other.pool;
+    file = std::move(other.file);
+    start = other.start;
+    numPages = other.numPages;
+    visited = other.visited;
+    other.pool = nullptr;
+  }
+  return *this;
+}
+
+SharedScan::~SharedScan() {
+  if (pool != nullptr) {
+    pool->endSharedScan(file);
+  }
+}
+
+size_t SharedScan::getStart() const { return start; }
+
+bool SharedScan::done() const { return visited == numPages; }
+
+std::pair<size_t, ReadPageGuard> SharedScan::next() {
+  if (done()) {
+    return {numPages, ReadPageGuard{}};
+  }
+  size_t page = (start + visited) % numPages;
+  visited++;
+  return {page, pool->getSharedScanPage(file, page)};
+}
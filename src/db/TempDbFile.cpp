@@ -0,0 +1,53 @@
+#include <db/TempDbFile.hpp>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <unistd.h>
+
+using namespace db;
+
+TempDbFile::TempDbFile(const std::string &name, size_t pageSize) : DbFile(name, pageSize) {
+  std::string path = (std::filesystem::temp_directory_path() / "db-XXXXXX").string();
+  fd = mkstemp(path.data());
+  if (fd == -1) {
+    throw std::runtime_error("Could not create a temporary file for " + name);
+  }
+  unlink(path.c_str());
+}
+
+TempDbFile::~TempDbFile() { close(fd); }
+
+void TempDbFile::readPage(std::span<char> page, const size_t id) const { readPages(page, id); }
+
+void TempDbFile::readPages(std::span<char> pages, const size_t id) const {
+  size_t done = 0;
+  while (done < pages.size()) {
+    ssize_t n = pread(fd, pages.data() + done, pages.size() - done, id * getPageSize() + done);
+    if (n == -1) {
+      throw std::runtime_error("Could not read page " + std::to_string(id) + " of " + getName());
+    }
+    if (n == 0) {
+      std::memset(pages.data() + done, 0, pages.size() - done);
+      break;
+    }
+    done += n;
+  }
+}
+
+void TempDbFile::writePage(std::span<const char> page, const size_t id) const { writePages(page, id); }
+
+void TempDbFile::writePages(std::span<const char> pages, const size_t id) const {
+  size_t done = 0;
+  while (done < pages.size()) {
+    ssize_t n = pwrite(fd, pages.data() + done, pages.size() - done, id * getPageSize() + done);
+    if (n == -1) {
+      throw std::runtime_error("Could not write page " + std::to_string(id) + " of " + getName());
+    }
+    done += n;
+  }
+  const size_t numPages = pages.size() / getPageSize();
+  extendTo(id + numPages);
+  for (size_t i = 0; i < numPages; i++) {
+    summarizePage(pages.subspan(i * getPageSize(), getPageSize()), id + i);
+  }
+}
@@ -0,0 +1,228 @@
+#include <db/PageGuard.hpp>
+#include <db/TransactionManager.hpp>
+#include <algorithm>
+
+using namespace db;
+
+template <typename T> static std::span<T> locate(std::span<T> page, size_t slot, size_t size) {
+  if (slot >= getTupleCount(page) || TUPLE_PAGE_HEADER + (slot + 1) * size > page.size()) {
+    throw std::out_of_range("No tuple in slot " + std::to_string(slot));
+  }
+  return page.subspan(TUPLE_PAGE_HEADER + slot * size, size);
+}
+
+static bool visible(const Transaction &txn, uint64_t writer, timestamp_t commitTs) {
+  return writer == txn.id || commitTs <= txn.startTs;
+}
+
+TransactionManager::TransactionManager(BufferPool &bufferPool)
+    : bufferPool(bufferPool), clock(0), nextId(1), undoSize(0) {}
+
+Transaction TransactionManager::begin() {
+  std::lock_guard lock(latch);
+  activeSnapshots.insert(clock);
+  return Transaction{nextId++, clock, UNCOMMITTED, {}, true};
+}
+
+TransactionGuard TransactionManager::beginGuarded() { return {this, begin()}; }
+
+void TransactionManager::finish(Transaction &txn) {
+  activeSnapshots.erase(activeSnapshots.find(txn.startTs));
+  txn.active = false;
+}
+
+void TransactionManager::commit(Transaction &txn) {
+  std::lock_guard lock(latch);
+  if (!txn.active) {
+    throw std::logic_error("Transaction has already finished");
+  }
+  txn.commitTs = ++clock;
+  for (const TupleId &tid : txn.writes) {
+    if (auto it = chains.find(tid); it != chains.end()) {
+      it->second.commitTs = txn.commitTs;
+    }
+  }
+  finish(txn);
+}
+
+void TransactionManager::undo(const TupleId &tid, std::span<char> page) {
+  auto it = chains.find(tid);
+  if (it == chains.end()) {
+    return;
+  }
+  Chain &chain = it->second;
+  Version &version = chain.undo.back();
+  if (!page.empty()) {
+    std::span<char> current = locate(page, tid.slot, version.data.size());
+    std::copy(version.data.begin(), version.data.end(), current.begin());
+  }
+  chain.writer = version.writer;
+  chain.commitTs = version.commitTs;
+  undoSize -= version.data.size();
+  chain.undo.pop_back();
+  if (chain.undo.empty()) {
+    chains.erase(it);
+  }
+}
+
+void TransactionManager::abort(Transaction &txn) {
+  if (!txn.active) {
+    throw std::logic_error("Transaction has already finished");
+  }
+  std::exception_ptr error;
+  for (auto tid = txn.writes.rbegin(); tid != txn.writes.rend(); ++tid) {
+    try {
+      WritePageGuard guard = bufferPool.fetchWrite(tid->pid);
+      std::lock_guard lock(latch);
+      undo(*tid, guard.getData());
+    } catch (...) {
+      // the tuple cannot be restored, but its chain still gives up the write
+      error = error ? error : std::current_exception();
+      std::lock_guard lock(latch);
+      undo(*tid, {});
+    }
+  }
+  {
+    std::lock_guard lock(latch);
+    finish(txn);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void TransactionManager::read(const Transaction &txn, const TupleId &tid, std::span<char> tuple) {
+  ReadPageGuard guard = bufferPool.fetchRead(tid.pid);
+  std::span<const char> current = locate(guard.getData(), tid.slot, tuple.size());
+  std::lock_guard lock(latch);
+  auto it = chains.find(tid);
+  if (it == chains.end() || visible(txn, it->second.writer, it->second.commitTs)) {
+    std::copy(current.begin(), current.end(), tuple.begin());
+    return;
+  }
+  for (auto version = it->second.undo.rbegin(); version != it->second.undo.rend(); ++version) {
+    if (visible(txn, version->writer, version->commitTs)) {
+      if (version->data.size() != tuple.size()) {
+        throw std::invalid_argument("Tuple size does not match the version of slot " + std::to_string(tid.slot));
+      }
+      std::copy(version->data.begin(), version->data.end(), tuple.begin());
+      return;
+    }
+  }
+  throw std::logic_error("No version of the tuple is visible to the transaction");
+}
+
+void TransactionManager::checkConflict(const Transaction &txn, const TupleId &tid) const {
+  auto it = chains.find(tid);
+  if (it != chains.end() && it->second.writer != txn.id && it->second.commitTs > txn.startTs) {
+    throw std::runtime_error("Write-write conflict on slot " + std::to_string(tid.slot) + " of page " +
+                             std::to_string(tid.pid.page) + " of " + tid.pid.file);
+  }
+}
+
+void TransactionManager::write(Transaction &txn, const TupleId &tid, std::span<const char> tuple) {
+  if (!txn.active) {
+    throw std::logic_error("Transaction has already finished");
+  }
+  {
+    // a conflicting write fails before the guard is taken, which would mark the page dirty
+    std::lock_guard lock(latch);
+    checkConflict(txn, tid);
+  }
+  WritePageGuard guard = bufferPool.fetchWrite(tid.pid);
+  std::span<char> current = locate(guard.getData(), tid.slot, tuple.size());
+  std::lock_guard lock(latch);
+  checkConflict(txn, tid);
+  Chain &chain = chains.try_emplace(tid, Chain{0, 0, {}}).first->second;
+  if (chain.writer != txn.id) {
+    chain.undo.push_back({std::vector<char>(current.begin(), current.end()), chain.writer, chain.commitTs});
+    undoSize += current.size();
+    chain.writer = txn.id;
+    chain.commitTs = UNCOMMITTED;
+    txn.writes.push_back(tid);
+  }
+  std::copy(tuple.begin(), tuple.end(), current.begin());
+}
+
+size_t TransactionManager::collectGarbage() {
+  std::lock_guard lock(latch);
+  timestamp_t oldest = activeSnapshots.empty() ? clock : *activeSnapshots.begin();
+  size_t dropped = 0;
+  for (auto it = chains.begin(); it != chains.end();) {
+    std::vector<Version> &undo = it->second.undo;
+    // the newest version visible to the oldest snapshot is the last one anybody can read
+    size_t keep = it->second.commitTs <= oldest ? undo.size() : 0;
+    for (size_t i = undo.size(); keep == 0 && i-- > 0;) {
+      if (undo[i].commitTs <= oldest) {
+        keep = i;
+      }
+    }
+    for (size_t i = 0; i < keep; i++) {
+      undoSize -= undo[i].data.size();
+    }
+    undo.erase(undo.begin(), undo.begin() + keep);
+    dropped += keep;
+    it = undo.empty() ? chains.erase(it) : std::next(it);
+  }
+  return dropped;
+}
+
+void TransactionManager::discardFile(const std::string &file) {
+  std::lock_guard lock(latch);
+  std::erase_if(chains, [&](const auto &entry) {
+    if (entry.first.pid.file != file) {
+      return false;
+    }
+    for (const Version &version : entry.second.undo) {
+      undoSize -= version.data.size();
+    }
+    return true;
+  });
+}
+
+size_t TransactionManager::getUndoSize() const {
+  std::lock_guard lock(latch);
+  return undoSize;
+}
+
+TransactionGuard::TransactionGuard(TransactionManager *manager, Transaction txn)
+    : manager(manager), txn(std::move(txn)) {}
+
+TransactionGuard::TransactionGuard(TransactionGuard &&other) noexcept
+    : manager(other.manager), txn(std::move(other.txn)) {
+  other.manager = nullptr;
+}
+
+TransactionGuard &TransactionGuard::operator=(TransactionGuard &&other) noexcept {
+  if (this != &other) {
+    abandon();
+    manager = other.manager;
+    txn = std::move(other.txn);
+    other.manager = nullptr;
+  }
+  return *this;
+}
+
+TransactionGuard::~TransactionGuard() { abandon(); }
+
+void TransactionGuard::abandon() noexcept {
+  if (manager != nullptr && txn.active) {
+    try {
+      manager->abort(txn);
+    } catch (...) {
+    }
+  }
+}
+
+TransactionManager &TransactionGuard::getManager() const {
+  if (manager == nullptr) {
+    throw std::logic_error("Transaction guard is empty");
+  }
+  return *manager;
+}
+
+Transaction &TransactionGuard::getTransaction() { return txn; }
+
+void TransactionGuard::commit() { getManager().commit(txn); }
+
+void TransactionGuard::abort() { getManager().abort(txn); }
@@ -0,0 +1,145 @@
+#include <db/Tuple.hpp>
+#include <algorithm>
+
+using namespace db;
+
+static size_t typeSize(type_t type) {
+  switch (type) {
+  case INT:
+    return INT_SIZE;
+  case DOUBLE:
+    return DOUBLE_SIZE;
+  case CHAR:
+    return CHAR_SIZE;
+  }
+  throw std::logic_error("Unknown type");
+}
+
+Tuple::Tuple(const std::vector<field_t> &fields) : fields(fields) {}
+
+type_t Tuple::getType(size_t i) const { return static_cast<type_t>(fields.at(i).index()); }
+
+size_t Tuple::size() const { return fields.size(); }
+
+const field_t &Tuple::getField(size_t i) const { return fields.at(i); }
+
+TupleDesc::TupleDesc(const std::vector<type_t> &types) : types(types), length(0) {
+  if (types.empty()) {
+    throw std::invalid_argument("A tuple needs at least one field");
+  }
+  for (type_t type : types) {
+    offsets.push_back(length);
+    length += typeSize(type);
+  }
+}
+
+size_t TupleDesc::size() const { return types.size(); }
+
+type_t TupleDesc::getType(size_t i) const { return types.at(i); }
+
+size_t TupleDesc::offsetOf(size_t i) const { return offsets.at(i); }
+
+size_t TupleDesc::getLength() const { return length; }
+
+bool TupleDesc::compatible(const Tuple &tuple) const {
+  if (tuple.size() != types.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < types.size(); i++) {
+    if (tuple.getType(i) != types[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TupleDesc::serialize(char *data, const Tuple &tuple) const {
+  if (!compatible(tuple)) {
+    throw std::invalid_argument("Tuple does not match the schema");
+  }
+  for (size_t i = 0; i < types.size(); i++) {
+    char *field = data + offsets[i];
+    switch (types[i]) {
+    case INT:
+      std::memcpy(field, &std::get<int>(tuple.getField(i)), INT_SIZE);
+      break;
+    case DOUBLE:
+      std::memcpy(field, &std::get<double>(tuple.getField(i)), DOUBLE_SIZE);
+      break;
+    case CHAR: {
+      const std::string &value = std::get<std::string>(tuple.getField(i));
+      if (value.size() > CHAR_SIZE) {
+        throw std::invalid_argument("String does not fit in a CHAR field");
+      }
+      std::memcpy(field, value.data(), value.size());
+      std::memset(field + value.size(), 0, CHAR_SIZE - value.size());
+      break;
+    }
+    }
+  }
+}
+
+Tuple TupleDesc::deserialize(const char *data) const {
+  std::vector<field_t> fields;
+  fields.reserve(types.size());
+  for (size_t i = 0; i < types.size(); i++) {
+    fields.push_back(getField(data, i));
+  }
+  return Tuple(fields);
+}
+
+field_t TupleDesc::getField(const char *data, size_t i) const {
+  const char *field = data + offsets.at(i);
+  switch (types[i]) {
+  case INT: {
+    int value;
+    std::memcpy(&value, field, INT_SIZE);
+    return value;
+  }
+  case DOUBLE: {
+    double value;
+    std::memcpy(&value, field, DOUBLE_SIZE);
+    return value;
+  }
+  case CHAR:
+    return std::string(field, strnlen(field, CHAR_SIZE));
+  }
+  throw std::logic_error("Unknown type");
+}
+
+size_t TupleDesc::pageCapacity(size_t pageSize) const { return (pageSize - TUPLE_PAGE_HEADER) / length; }
+
+size_t TupleDesc::tupleCount(std::span<const char> page) const {
+  return std::min<size_t>(getTupleCount(page), pageCapacity(page.size()));
+}
+
+bool TupleDesc::appendTuple(std::span<char> page, const Tuple &tuple) const {
+  uint32_t count = getTupleCount(page);
+  if (count >= pageCapacity(page.size())) {
+    return false;
+  }
+  serialize(page.data() + TUPLE_PAGE_HEADER + count * length, tuple);
+  setTupleCount(page, count + 1);
+  return true;
+}
+
+void TupleDesc::scanPage(std::span<const char> page, const std::function<void(const Tuple &)> &visit) const {
+  const char *data = page.data() + TUPLE_PAGE_HEADER;
+  const size_t count = tupleCount(page);
+  for (size_t slot = 0; slot < count; slot++, data += length) {
+    visit(deserialize(data));
+  }
+}
+
+std::vector<size_t> TupleDesc::filter(std::span<const char> page, size_t field,
+                                      const std::function<bool(const field_t &)> &predicate) const {
+  std::vector<size_t> slots;
+  const char *data = page.data() + TUPLE_PAGE_HEADER;
+  const size_t count = tupleCount(page);
+  for (size_t slot = 0; slot < count; slot++, data += length) {
+    if (predicate(getField(data, field))) {
+      slots.push_back(slot);
+    }
+  }
+  return slots;
+}
@@ -1,18 +1,27 @@
 #pragma once
 
+#include <db/CompressedTier.hpp>
+#include <db/FrameAllocator.hpp>
 #include <db/types.hpp>
-#include <list>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 /*
  * The bufferpool is implemented in the most logical way, using a doubly-linked list
- * as the backend data structure for LRU. For this purpose, I use the pageControlBlock (PCB)
- * As the structure for each linked-list block, containing the pageId, page, isDirty, and next
- * and prev pointers for the linked list. The list is managed and scaled dynamically with
- * the DEFAULT_NUM_PAGES as it checks at every function if the limit has been used or reached
- * respective of the function's purpose. The description of what each function does are labeled
+ * as the backend data structure for LRU. For this purpose, I use the frame descriptor (FrameDesc)
+ * As the structure for each linked-list block, containing the page key, frame, pin count, dirty
+ * and reference bits, and next and prev links for the linked list. The list is managed and scaled
+ * dynamically with the memory budget as it checks at every function if the limit has been used or
+ * reached respective of the function's purpose. The description of what each function does are labeled
  * above each respective function as a brief and note, but most information will be here at the top
  * of the hpp file. No additional notes are made in the .ccp file for the sake of good code styling.
  * The rest of specific design choices and notes I will list here:
@@ -21,16 +30,16 @@
  * 1) Each function behaves exactly as the TODOs listed and I did not remove the TODOs as
  * they are good descriptors of what each function does.
  *
- * 2) I use three pointers to manage the linked list which are first and last, which simply
- * point to the first and last PCB in the list respectively, and current, which is changed
- * according to which page needs to be looked at at a present moment.
+ * 2) I use two links to manage the linked list which are first and last, which simply
+ * point to the first and last descriptor in the list respectively. They are members of
+ * the bufferpool so that separate pools do not share a list.
  *
  * 3) Every function that innately assumes that a pid is in the Database or the bufferpool
  * will throw a logic error 'No such page in bufferpool' if that page does not exist in the
  * bufferpool.
  *
- * 4) For the sake of reducing code repetitiveness, I added the function searchPid, which
- * simply searches and sets the current pointer to the specified pid.
+ * 4) For the sake of reducing code repetitiveness, I added the function find, which
+ * simply returns the descriptor of the specified pid (or NO_FRAME) from the page table.
  *
  * 5) There are two more helper functions: searchFile and discardFile, which respectively
  * do as the name entails. The first checks if a page from a particular file exists in the
@@ -45,22 +54,126 @@
  * states, we are only to implement functions and not care about the efficiency too much.
  * However if you have any recommendations on better ways of accessing the Database in these
  * functions they would be greatly appreciated.
+ *
+ * 7) Files that expose their pages directly (DbFile::mappedPage, e.g. MmapDbFile) are read without
+ * copying through the read-only accessors, viewPage and fetchRead: on a miss they ask the file for a
+ * mapped view and return it as is, so these pages never take a slot, are never evicted and are not
+ * reported by contains. The mapping is read-only, so the mutable accessors (getPage, getPageSpan and
+ * the ScanRings) copy such pages into a frame instead, and markDirty and fetchWrite reject them.
+ *
+ * 8) Each file declares its own page size (DbFile::getPageSize), so the descriptor does not hold
+ * the page inline. Frames come from a FrameAllocator, which keeps one arena per page size class on
+ * top of a single memory budget of DEFAULT_NUM_PAGES default-sized pages. A miss evicts from the
+ * LRU end until the allocator can produce a frame of the right size, so one 64 KiB page may evict
+ * several 4 KiB ones. getPageSpan works for every page size; getPage is kept for files that use
+ * DEFAULT_PAGE_SIZE and throws for the others.
+ *
+ * 9) The allocator's budget is reserved in one mapping when the pool is built, on 1 GiB or 2 MiB
+ * huge pages if the host has them and on regular pages with transparent huge pages otherwise.
+ * On hosts with several NUMA nodes the mapping is interleaved (or partitioned) across the nodes
+ * before it is touched. What was actually obtained is reported by getMemoryLayout.
+ *
+ * 10) The descriptors live in one dense array, sized for the largest number of frames the budget
+ * can hold, and link to each other by index. A descriptor is 32 bytes, so two share a cache line
+ * and walking the LRU list, flushing or scanning a file touches packed metadata only, never the
+ * 4 KiB (or larger) frames. The PageId's file name is interned once into a 16 bit file id and
+ * packed with the page number into a 64 bit key, and a hash table maps keys to descriptors, so
+ * lookups no longer walk the list. discardFile frees the id once none of the file's pages are left
+ * in either tier, and later files reuse it. Eviction skips descriptors that are pinned.
+ *
+ * 11) Bulk scans go through a ScanRing (beginScan), which owns a handful of frames outside of the
+ * LRU list and recycles them oldest first, so a full scan cannot push the hot set out of the pool.
+ * Pages that were already resident are used in place. Ring state lives in the pool and descriptors
+ * only store the ring id, which keeps ScanRing handles cheap to move.
+ *
+ * 12) Concurrent full scans of one file are synchronized (beginSharedScan). The pool keeps one
+ * group per file with a shared ring and the page the group read last. A new scan starts from that
+ * page and wraps around, so it trails the others closely and reads their pages from the ring.
+ * Each scan holds a ReadPageGuard on its current page, and the ring only recycles unpinned
+ * frames. The group and its ring go away with its last scan.
+ *
+ * 13) getPage hands out a bare reference that is only valid until the page is evicted. The page
+ * guards (fetchRead and fetchWrite) are the safe way to use a page: they pin the descriptor so
+ * eviction and the scan rings skip it, and they hold a shared or exclusive latch on the frame.
+ * The latches are kept in an array parallel to the descriptors so the descriptors stay small.
+ * Every public function takes the bufferpool latch, which protects the descriptors, the page
+ * table and the rings. A frame latch is only ever acquired after the bufferpool latch has been
+ * released, and the pin taken beforehand keeps the frame in place in between. Write guards mark
+ * their page dirty when they are released, so a flush that races with a writer leaves the page
+ * dirty and the final contents are written later. Write-back always happens under a frame latch:
+ * flushes pin their pages and copy each one under its shared latch once the bufferpool latch is
+ * released, and eviction and the scan rings only take frames whose latch they can acquire right
+ * away, so a flush never writes out half of a writer's update.
+ *
+ * 14) An optional second tier (enableSecondTier) keeps compressed copies of the pages that evict
+ * pushes out, after they have been flushed. A miss checks it before reading the page from disk,
+ * and the page leaves the second tier when it comes back, so no page is cached twice. Ring pages
+ * are not spilled, so scans do not flood it. discardFile also drops the file's pages from it and
+ * getStats reports hits and misses per tier.
+ *
+ * 15) With warm start enabled, a background thread restores the pages listed in the dump file
+ * (one "page<TAB>file" line per page, most recently used first) and then rewrites the dump every
+ * interval, and the destructor writes it a last time. Restoring goes hottest first, but each
+ * batch of WARM_START_BATCH pages is sorted by file and page number so the reads are sequential.
+ * Prefetching only uses free frames and takes the bufferpool latch one page at a time, so it
+ * never evicts pages that traffic has brought in and never holds up requests for long. The page
+ * gets its descriptor before the read is queued, pinned and marked as loading: lookups of the
+ * page wait for the read instead of reading it a second time or seeing a half-read frame, and
+ * discardFile waits for it too, so the file outlives the read.
+ *
+ * 16) Disk I/O goes through the Database's IoScheduler, tagged with a class. Misses are
+ * ForegroundRead and run inline, ring misses are Bulk, warm start reads are Prefetch and are
+ * queued without holding the bufferpool latch (see 15), and flushes are BackgroundWrite. flushFile and the destructor queue all their
+ * dirty pages at once in page order, so the scheduler merges neighbours into single writes. No
+ * write happens under the bufferpool latch: flushes wait for their writes with the latch
+ * released, and a miss whose victim is dirty writes it back with the latch released and then
+ * looks for a victim again, so lookups of other threads are never stuck behind a write.
  */
 
-typedef struct pageControlBlock {
-  db::PageId pageId;
-  db::Page page;
+namespace db {
+constexpr size_t DEFAULT_NUM_PAGES = 50;
+constexpr size_t DEFAULT_RING_PAGES = 8;
+constexpr size_t WARM_START_BATCH = 32;
+constexpr std::chrono::milliseconds DEFAULT_WARM_START_INTERVAL = std::chrono::minutes(1);
+
+class DbFile;
+class ReadPageGuard;
+class WritePageGuard;
+class ScanRing;
+class SharedScan;
+
+/**
+ * @brief The metadata of one frame of the bufferpool.
+ * @details The key packs the interned file id in its upper 16 bits and the page number in the
+ * lower 48. prev and next are indices of other descriptors in the LRU list. A descriptor
+ * without a frame is free, and a descriptor with a ring id belongs to that ScanRing instead
+ * of the LRU list. pinCount is 16 bits wide to keep the descriptor at 32 bytes, so taking a
+ * pin past its maximum throws instead of wrapping. isLoading is set while a prefetch reads the
+ * page into the frame without holding the bufferpool latch.
+ */
+struct alignas(32) FrameDesc {
+  uint64_t key;
+  char *frame;
+  uint32_t prev;
+  uint32_t next;
+  uint16_t pinCount;
+  uint16_t ring;
+  uint8_t sizeClass;
   bool isDirty;
-  struct pageControlBlock *next;
-  struct pageControlBlock *prev;
-} PCB;
+  bool isReferenced;
+  bool isLoading;
+};
+static_assert(sizeof(FrameDesc) == 32);
 
-static PCB * first;
-static PCB * current;
-static PCB * last;
+/**
+ * @brief Statistics of the bufferpool and of its optional second tier.
+ */
+struct BufferPoolStats {
+  TierStats primary;
+  TierStats secondary;
+  size_t secondarySize;
+};
 
-namespace db {
-constexpr size_t DEFAULT_NUM_PAGES = 50;
 /**
  * @brief Represents a buffer pool for database pages.
  * @details The BufferPool class is responsible for managing the database pages in memory.
@@ -71,19 +184,252 @@ constexpr size_t DEFAULT_NUM_PAGES = 50;
 
 
 class BufferPool {
+  friend class ReadPageGuard;
+  friend class WritePageGuard;
+  friend class ScanRing;
+  friend class SharedScan;
+
   // TODO pa1: add private members
 private:
+  static constexpr uint32_t NO_FRAME = UINT32_MAX;
+  static constexpr uint16_t NO_RING = 0;
+
+  struct RingState {
+    size_t capacity;
+    std::deque<uint32_t> slots;
+    bool active;
+  };
+
+  struct SharedScanGroup {
+    uint16_t ring;
+    size_t position;
+    size_t participants;
+  };
+
+  mutable std::mutex latch;
+  FrameAllocator frames;
+  std::vector<FrameDesc> descs;
+  std::unique_ptr<std::shared_mutex[]> frameLatches;
+  std::vector<uint32_t> freeDescs;
+  std::unordered_map<uint64_t, uint32_t> table;
+  std::vector<std::string> fileNames;
+  std::unordered_map<std::string, uint16_t> fileIds;
+  std::vector<uint16_t> freeFileIds;
+  uint32_t first;
+  uint32_t last;
+  std::vector<RingState> rings;
+  std::unordered_map<std::string, SharedScanGroup> sharedScans;
+  std::unique_ptr<CompressedTier> secondTier;
+  TierStats primaryStats;
+  std::thread warmStartThread;
+  std::mutex warmStartMutex;
+  std::condition_variable warmStartCv;
+  std::condition_variable loaded;
+  bool warmStartStopping;
+  bool warmStartPrefetching;
+  std::string warmStartPath;
+
+  /**
+   * @brief: Returns the key of a page, or nothing if its file has no pages in the bufferpool.
+   */
+  std::optional<uint64_t> keyOf(const PageId &pid) const;
+
+  /**
+   * @brief: Returns the key of a page, interning its file name if needed.
+   */
+  uint64_t internKey(const PageId &pid);
+
+  /**
+   * @brief: Returns the page id stored in a descriptor.
+   */
+  PageId pageIdOf(const FrameDesc &desc) const;
+
+  /**
+   * @brief: Returns the descriptor of the page, or NO_FRAME if the page is not in the bufferpool.
+   */
+  uint32_t find(const PageId &pid) const;
+
+  /**
+   * @brief: find, but waits for a prefetch of the page that is in progress to complete first.
+   * @param lock: The held bufferpool latch, which is released while waiting.
+   */
+  uint32_t findLoaded(std::unique_lock<std::mutex> &lock, const PageId &pid);
+
+  /**
+   * @brief: Removes a descriptor from the LRU list.
+   */
+  void unlink(uint32_t index);
+
+  /**
+   * @brief: Inserts a descriptor at the most recently used end of the LRU list.
+   */
+  void pushFront(uint32_t index);
+
+  /**
+   * @brief: Inserts a descriptor at the least recently used end of the LRU list.
+   */
+  void pushBack(uint32_t index);
+
+  /**
+   * @brief: Returns the frame of a descriptor.
+   */
+  static std::span<char> frameOf(const FrameDesc &desc);
+
+  /**
+   * @brief: Makes a resident page the most recently used page, taking it out of its ScanRing if it
+   * belongs to one.
+   */
+  void touch(uint32_t index);
 
+  /**
+   * @brief: Returns the page with the specified page id, reading it into a frame if needed, see
+   * getPageSpan. Pages of mapped files are copied into a frame too.
+   * @param lock: The held bufferpool latch, which a miss may release while it writes back a page.
+   * @param index: Set to the descriptor of the page.
+   */
+  std::span<char> fetch(std::unique_lock<std::mutex> &lock, const PageId &pid, uint32_t &index);
+
+  /**
+   * @brief: Returns the page straight from the mapping of its file, or an empty span if the file is
+   * not mapped or the page already has a frame.
+   */
+  std::span<const char> mappedView(const PageId &pid) const;
+
+  /**
+   * @throws std::logic_error if the page belongs to a read-only mapped file.
+   */
+  void checkWritable(const PageId &pid) const;
+
+  /**
+   * @brief: Takes a pin on a page so it cannot be evicted.
+   * @throws std::overflow_error if the page already holds the largest number of pins a FrameDesc can count.
+   */
+  void pin(uint32_t index);
+
+  /**
+   * @brief: Releases the pin of a page guard, marking the page dirty if it was written.
+   */
+  void unpin(uint32_t index, bool dirty);
+
+  /**
+   * @brief: Reads a page that is not resident into a new frame, evicting pages as needed.
+   * @param lock: The held bufferpool latch, see evict.
+   * @param ring: The ScanRing that owns the new frame, or NO_RING to insert it into the LRU list.
+   * @return: The descriptor of the page, which another thread may have read in the meantime.
+   */
+  uint32_t install(std::unique_lock<std::mutex> &lock, const PageId &pid, const DbFile &file, uint16_t ring);
+
+  /**
+   * @brief: Gives a descriptor to a page whose frame is already allocated.
+   * @param ring: The ScanRing that owns the frame, or NO_RING to insert it into the LRU list.
+   * @return: The descriptor of the page.
+   */
+  uint32_t adopt(const PageId &pid, char *frame, size_t pageSize, uint16_t ring);
+
+  /**
+   * @brief: Writes the dirty pages among some descriptors as queued background writes, so that
+   * adjacent pages are written together, and waits for them.
+   * @details: The pages are pinned and the bufferpool latch is released while they are written.
+   * Each page is copied under its shared frame latch, so no writer is in the middle of it.
+   * @param lock: The held bufferpool latch. It is held again when the function returns.
+   */
+  void flushAll(std::unique_lock<std::mutex> &lock, std::vector<uint32_t> indices);
+
+  /**
+   * @brief: Body of the warm start thread: prefetches the dumped pages, then dumps the resident
+   * pages every interval until the bufferpool is destroyed.
+   */
+  void warmStart(std::vector<PageId> pages, std::chrono::milliseconds interval);
+
+  /**
+   * @brief: Reads a page into a free frame as the least recently used page, without evicting.
+   * The read is queued as a Prefetch request without holding the bufferpool latch.
+   * @return: False if the bufferpool is full, true otherwise (including when the page is skipped).
+   */
+  bool prefetch(const PageId &pid);
+
+  /**
+   * @brief: Reserves the state of a new ScanRing and returns its id.
+   */
+  uint16_t openRing(size_t ringPages);
+
+  /**
+   * @brief: Returns a page through a ScanRing, see ScanRing::getPageSpan.
+   */
+  std::span<char> getRingPage(uint16_t ring, const PageId &pid);
+
+  /**
+   * @brief: Returns a page through a ScanRing, pinned and under a shared latch, see ScanRing::fetchRead.
+   */
+  ReadPageGuard fetchRingRead(uint16_t ring, const PageId &pid);
+
+  /**
+   * @brief: getRingPage, for callers that already hold the bufferpool latch. A dirty frame of the
+   * ring is written back with the latch released before it is recycled.
+   * @return: The descriptor of the page.
+   */
+  uint32_t ringPage(std::unique_lock<std::mutex> &lock, uint16_t ring, const PageId &pid);
+
+  /**
+   * @brief: Releases a ScanRing, moving its frames to the least recently used end of the LRU list.
+   */
+  void endScan(uint16_t ring);
+
+  /**
+   * @brief: endScan, for callers that already hold the bufferpool latch.
+   */
+  void closeRing(uint16_t ring);
+
+  /**
+   * @brief: Returns a page through the ring of a group of SharedScans and records it as the
+   * group's position. The guard pins the page, so the ring does not recycle its frame while the
+   * scan still reads it.
+   */
+  ReadPageGuard getSharedScanPage(const std::string &file, size_t page);
+
+  /**
+   * @brief: Removes a SharedScan from its group, releasing the group with its last scan.
+   */
+  void endSharedScan(const std::string &file);
+
+  /**
+   * @brief: Writes a dirty page to disk on the calling thread, pinned and under its shared frame
+   * latch, with the bufferpool latch released in the meantime.
+   * @param lock: The held bufferpool latch. It is held again when the function returns.
+   */
+  void writeBack(std::unique_lock<std::mutex> &lock, uint32_t index);
+
+  /**
+   * @brief: Removes a descriptor from the bufferpool (LRU list or ScanRing) and returns its frame
+   * to the allocator.
+   */
+  void release(uint32_t index);
+
+  /**
+   * @brief: Evicts the least recently used page that is neither pinned nor latched. If that page is
+   * dirty, it is written back instead (writeBack) and stays resident, so the caller tries again.
+   * @return: Whether a page was evicted. If not, the bufferpool latch was released for a while.
+   * @throws std::runtime_error if every page is pinned.
+   */
+  bool evict(std::unique_lock<std::mutex> &lock);
 
-  int freePages;
 public:
   /**
    * @brief: Constructs a BufferPool object with the default number of pages.
    */
   explicit BufferPool();
 
+  /**
+   * @brief: Constructs a BufferPool object with a memory budget of the given size.
+   * @param capacity: The budget in bytes, shared by the frames of all page sizes.
+   * @param numaPolicy: How the frames are spread over the NUMA nodes of the host.
+   * @note The whole budget is reserved up front, on huge pages when the host provides them.
+   */
+  explicit BufferPool(size_t capacity, NumaPolicy numaPolicy = NumaPolicy::Interleave);
+
   /**
    * @brief: Destructs a BufferPool object after flushing all dirty pages to disk.
+   * @note If warm start is enabled, the resident pages are dumped first.
    */
   ~BufferPool();
 
@@ -95,14 +441,118 @@ public:
 
   BufferPool &operator=(BufferPool &&) = delete;
 
+  /**
+   * @brief: Returns how the frame memory was reserved: its size, the kind of pages backing it
+   * and its placement on the NUMA nodes.
+   */
+  const MemoryLayout &getMemoryLayout() const;
+
+  /**
+   * @brief: Returns the ids of the pages in the LRU list, from the most to the least recently used.
+   */
+  std::vector<PageId> getResidentPages() const;
+
+  /**
+   * @brief: Writes the ids of the pages in the LRU list to a file, most recently used first.
+   * @param path: The file to write. It is replaced atomically.
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void dumpResidentPages(const std::string &path) const;
+
+  /**
+   * @brief: Restores the pages dumped by a previous bufferpool and keeps the dump up to date.
+   * @param path: The dump file. It is fine if it does not exist yet.
+   * @param interval: How often the resident pages are dumped while the bufferpool is running.
+   * @throws std::logic_error if warm start is already enabled.
+   * @note The dumped pages are prefetched in the background, hottest first and in batches of
+   * WARM_START_BATCH sorted by file offset, into free frames only. Requests are served meanwhile.
+   * The resident pages are dumped one last time when the bufferpool is destroyed.
+   */
+  void enableWarmStart(const std::string &path,
+                       std::chrono::milliseconds interval = DEFAULT_WARM_START_INTERVAL);
+
+  /**
+   * @brief: Waits until the pages of the warm start dump have been prefetched.
+   */
+  void awaitWarmStart();
+
+  /**
+   * @brief: Adds a compressed second tier behind the bufferpool, replacing any previous one.
+   * @param capacity: The memory budget of the second tier in bytes, separate from the bufferpool's.
+   * @note Clean pages evicted from the bufferpool are compressed into the second tier, and misses look
+   * there before reading from disk.
+   */
+  void enableSecondTier(size_t capacity);
+
+  /**
+   * @brief: Returns the hit and miss counts of the bufferpool and of the second tier, and the size of
+   * the second tier.
+   */
+  BufferPoolStats getStats() const;
+
   /**
    * @brief: Returns the page with the specified page id.
    * @param pid: The page id of the page to return.
    * @return: The page with the specified page id.
    * @note This method should make this page the most recently used page.
+   * @note Pages of files that are mapped into memory are copied into a frame like any other page. Use
+   * viewPage or fetchRead to read them in place.
+   * @throws std::logic_error if the page size of the file is not `DEFAULT_PAGE_SIZE`.
    */
   Page &getPage(const PageId &pid);
 
+  /**
+   * @brief: Returns the page with the specified page id, for files of any page size.
+   * @param pid: The page id of the page to return.
+   * @return: A view of the frame holding the page. Its size is the page size of the file.
+   * @note This method should make this page the most recently used page.
+   */
+  std::span<char> getPageSpan(const PageId &pid);
+
+  /**
+   * @brief: Returns a read-only view of the page with the specified page id.
+   * @param pid: The page id of the page to return.
+   * @return: A view of the page. Its size is the page size of the file.
+   * @note Pages of files that are mapped into memory are returned straight from the mapping, without
+   * taking a frame, unless they already have one. Other pages are fetched like getPageSpan does.
+   */
+  std::span<const char> viewPage(const PageId &pid);
+
+  /**
+   * @brief: Returns a guard that pins the page and holds a shared latch on it.
+   * @param pid: The page id of the page to read.
+   * @return: The guard. The page cannot be evicted or written by others until it is released.
+   * @note This method should make this page the most recently used page.
+   */
+  ReadPageGuard fetchRead(const PageId &pid);
+
+  /**
+   * @brief: Returns a guard that pins the page and holds an exclusive latch on it.
+   * @param pid: The page id of the page to write.
+   * @return: The guard. The page is marked dirty when the guard is released.
+   * @throws std::logic_error if the page belongs to a read-only mapped file.
+   * @note This method should make this page the most recently used page.
+   */
+  WritePageGuard fetchWrite(const PageId &pid);
+
+  /**
+   * @brief: Starts a bulk scan that reads through a private ring of frames.
+   * @param ringPages: The number of frames in the ring.
+   * @return: The ring. Pages are read through it until it is destroyed.
+   * @throws std::invalid_argument if the ring is empty or larger than half of the bufferpool.
+   * @note The ring only takes frames from the bufferpool while it fills up. See ScanRing.
+   */
+  ScanRing beginScan(size_t ringPages = DEFAULT_RING_PAGES);
+
+  /**
+   * @brief: Starts a full scan of a file that shares its reads with the scans of the file in progress.
+   * @param file: The name of the file to scan.
+   * @return: The scan. It starts at the page last read by the other scans of the file, or at page 0.
+   * @throws std::logic_error if the file does not exist.
+   * @note See SharedScan.
+   */
+  SharedScan beginSharedScan(const std::string &file);
+
   /**
    * @brief: Marks the page with the specified page id as dirty.
    * @param pid: The page id of the page to mark as dirty.
@@ -126,11 +576,20 @@ public:
   /**
    * @brief: Discards the page with the specified page id from the buffer pool.
    * @param pid: The page id of the page to discard.
+   * @throws std::logic_error if the page is pinned by a page guard.
    * @note This method does NOT flush the page to disk.
    * @note This method also updates the LRU and dirty pages to exclude tracking this page.
    */
   void discardPage(const PageId &pid);
 
+  /**
+   * @brief: Drops every cached copy of the page with the specified page id, in both tiers.
+   * @param pid: The page id of the page to drop.
+   * @throws std::logic_error if the page is pinned by a page guard.
+   * @note This method does NOT flush the page to disk, and does nothing if the page is not cached.
+   */
+  void invalidate(const PageId &pid);
+
   /**
    * @brief: Flushes the page with the specified page id to disk.
    * @param pid: The page id of the page to flush.
@@ -144,15 +603,6 @@ public:
    */
   void flushFile(const std::string &file);
 
-  /**
-   * @brief: Helper function which sets the current pointer to the page with
-   * the input PageId.
-   * @note Does not check for existence of the page. This check is
-   * performed by each function individually based on what each function is looking
-   * for.
-   */
-  void searchPid(const PageId &pid) const;
-
   /**
    * @brief: Helper function which simply returns if a page from specified file
    * name exists in the bufferpool.
@@ -164,6 +614,7 @@ public:
    * @note  Does not flush the file and assumes a flushFile has already been performed.
    * Used solely for a database remove function in order to erase any pages in bufferpool
    * from a file that has been deleted from the database.
+   * @note The file id of the file is freed, to be reused by files added later.
    */
   void discardFile(const std::string &file);
 
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <db/DbFile.hpp>
+#include <future>
+
+namespace db {
+constexpr size_t DEFAULT_BULK_BATCH_PAGES = 64;
+
+/**
+ * @brief Appends a large number of pages to the end of a file without going through the BufferPool.
+ * @details Pages are built in one of two page-aligned staging batches. When a batch is full it is written with a
+ * single DbFile::writePages call, queued as a Bulk request of the IoScheduler, while the caller fills the other
+ * batch, so the file is written sequentially, in large requests, and page construction overlaps with I/O. The
+ * BufferPool is never used, which keeps the load from evicting the working set.
+ * @note The file must not be written through the BufferPool while pages are appended to it.
+ */
+class BulkAppender {
+  const DbFile &file;
+  const size_t pageSize;
+  const size_t batchPages;
+  std::array<char *, 2> batches;
+  size_t batch;
+  size_t staged;
+  size_t firstPage;
+  size_t appended;
+  std::future<void> pending;
+  bool finished;
+
+  /**
+   * @brief Starts writing the current batch in the background and switches to the other one.
+   */
+  void submit();
+
+public:
+  /**
+   * @brief Starts appending pages after the last page of the file.
+   * @param file The file to append to.
+   * @param batchPages The number of pages written per request.
+   * @throws std::invalid_argument if the batch is empty.
+   */
+  explicit BulkAppender(const DbFile &file, size_t batchPages = DEFAULT_BULK_BATCH_PAGES);
+
+  /**
+   * @brief Writes the remaining pages, see finish.
+   * @note Errors are only reported by finish.
+   */
+  ~BulkAppender();
+
+  BulkAppender(const BulkAppender &) = delete;
+
+  BulkAppender &operator=(const BulkAppender &) = delete;
+
+  /**
+   * @brief Returns the next page to fill. It is zeroed and its size is the page size of the file.
+   * @note The page is only valid until the next call to nextPage or finish.
+   * @throws std::logic_error if the appender is finished.
+   */
+  std::span<char> nextPage();
+
+  /**
+   * @brief Writes the remaining pages and waits for all writes to complete.
+   * @details The appended pages are then part of the file. Stale copies of them that the BufferPool may hold, in
+   * either tier, are discarded.
+   * @return The page number of the first appended page.
+   * @throws std::runtime_error, or any other error of DbFile::writePages, if a write failed.
+   */
+  size_t finish();
+
+  /**
+   * @brief Returns the number of pages appended so far, including pages that are still staged.
+   */
+  size_t getNumAppended() const;
+};
+} // namespace db
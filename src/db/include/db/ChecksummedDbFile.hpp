@@ -0,0 +1,98 @@
+#pragma once
+
+#include <db/DbFile.hpp>
+#include <db/PageChecksum.hpp>
+#include <atomic>
+
+namespace db {
+
+/**
+ * @brief Represents a database file on disk whose pages are checksummed, so corruption is caught when a page is
+ * read instead of when a query returns garbage.
+ * @details Every page is stored sealed (sealPage): an 8-byte header with the LSN of the write, the page, and a
+ * trailer with the LSN again and a CRC32C of the slot. The CRC uses the SSE4.2 crc32 instruction, which verifies a
+ * 4 KiB page well under a microsecond. The LSN pair catches torn writes: when only part of a slot reached the disk,
+ * its header and trailer come from different writes. LSNs grow with every write to the file and continue from the
+ * largest LSN on disk when the file is opened, so a rewrite never reuses the LSN of an earlier write, whatever the
+ * clock does. Slots are padded to a multiple
+ * of the block size (sealedSize), so every write covers whole blocks and never shares one with a neighbouring
+ * page, and the pages handed out keep the full page size. With the default 512-byte sectors a 4 KiB page takes
+ * 4.5 KiB on disk; a block size of 4096 aligns slots to file system pages at the cost of a page of padding.
+ * @note Scrubber walks these files in the background with checkPage, without going through the BufferPool.
+ */
+class ChecksummedDbFile : public DbFile {
+  const std::string path;
+  const size_t slotSize;
+  int fd;
+  mutable std::atomic<uint64_t> nextLsn;
+
+  /**
+   * @brief Reads the sealed slots of consecutive pages. Slots past the end of the file read as zeros.
+   */
+  void readSlots(std::span<char> slots, size_t id) const;
+
+public:
+  /**
+   * @brief Opens or creates a checksummed file.
+   * @param name The name of the file in the catalog.
+   * @param path The path of the file on disk. Its existing pages are kept.
+   * @param pageSize The size of every page of the file.
+   * @param blockSize The block size that slots are padded to. A file must be reopened with the same one.
+   * @throws std::invalid_argument if the block size is 0.
+   * @throws std::runtime_error if the file cannot be opened or read.
+   * @note The existing slots are read once to find the largest LSN on disk.
+   */
+  ChecksummedDbFile(const std::string &name, const std::string &path, size_t pageSize = DEFAULT_PAGE_SIZE,
+                    size_t blockSize = DEFAULT_CHECKSUM_BLOCK_SIZE);
+
+  /**
+   * @brief Closes the file descriptor. The file stays on disk.
+   */
+  ~ChecksummedDbFile() override;
+
+  ChecksummedDbFile(const ChecksummedDbFile &) = delete;
+
+  ChecksummedDbFile &operator=(const ChecksummedDbFile &) = delete;
+
+  const std::string &getPath() const;
+
+  /**
+   * @brief Returns the size of a sealed page on disk, see sealedSize.
+   */
+  size_t getSlotSize() const;
+
+  /**
+   * @brief Returns the number of pages in the file, including those written before it was opened.
+   */
+  size_t getNumPages() const override;
+
+  /**
+   * @brief Reads and verifies a page. Pages that were never written read as zeros.
+   * @throws std::runtime_error if the read fails, if the page is torn or if its checksum does not match.
+   */
+  void readPage(std::span<char> page, size_t id) const override;
+
+  /**
+   * @brief Reads consecutive pages with a single pread and verifies each of them.
+   * @throws std::runtime_error if the read fails, if a page is torn or if its checksum does not match.
+   */
+  void readPages(std::span<char> pages, size_t id) const override;
+
+  /**
+   * @throws std::runtime_error if the write fails.
+   */
+  void writePage(std::span<const char> page, size_t id) const override;
+
+  /**
+   * @brief Seals consecutive pages under new LSNs and writes them with a single pwrite.
+   * @throws std::runtime_error if the write fails.
+   */
+  void writePages(std::span<const char> pages, size_t id) const override;
+
+  /**
+   * @brief Reads and verifies a page without returning it, for scrubbing.
+   * @throws std::runtime_error if the read fails.
+   */
+  PageStatus checkPage(size_t id) const;
+};
+} // namespace db
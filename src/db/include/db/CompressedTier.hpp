@@ -0,0 +1,78 @@
+#pragma once
+
+#include <db/types.hpp>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace db {
+
+/**
+ * @brief Hit and miss counters of one cache tier.
+ */
+struct TierStats {
+  size_t hits;
+  size_t misses;
+};
+
+/**
+ * @brief A second cache tier that keeps compressed copies of clean pages evicted from the BufferPool.
+ * @details Pages are stored under the BufferPool's packed page keys, compressed with compressPage, and evicted in
+ * LRU order when the tier's own memory budget is exceeded. The tier is exclusive: a page leaves it when it is taken
+ * back into the BufferPool, so a page is never cached twice. Pages that do not compress are not kept.
+ */
+class CompressedTier {
+  struct Entry {
+    std::vector<char> data;
+    std::list<uint64_t>::iterator lru;
+  };
+
+  const size_t capacity;
+  size_t used;
+  std::unordered_map<uint64_t, Entry> entries;
+  std::list<uint64_t> lru;
+  TierStats stats;
+
+  void erase(std::unordered_map<uint64_t, Entry>::iterator it);
+
+public:
+  /**
+   * @brief Constructs an empty tier.
+   * @param capacity The budget for the compressed pages, in bytes.
+   */
+  explicit CompressedTier(size_t capacity);
+
+  /**
+   * @brief Compresses a page and keeps it as the most recently used page of the tier.
+   * @param key The packed key of the page.
+   * @param page The contents of the page. The page must be clean.
+   */
+  void put(uint64_t key, std::span<const char> page);
+
+  /**
+   * @brief Takes a page out of the tier.
+   * @param key The packed key of the page.
+   * @return The compressed page, to be restored with decompressPage, or an empty vector on a miss.
+   * @note The page is taken out before the BufferPool makes room for it, so that the evictions this
+   * causes cannot push the page out of the tier.
+   */
+  std::vector<char> take(uint64_t key);
+
+  /**
+   * @brief Drops a page from the tier, if it is there.
+   */
+  void discard(uint64_t key);
+
+  /**
+   * @brief Drops every page whose key matches the given key under the mask.
+   */
+  void discardMatching(uint64_t key, uint64_t mask);
+
+  /**
+   * @brief Returns the number of bytes of compressed pages held by the tier.
+   */
+  size_t getSize() const;
+
+  const TierStats &getStats() const;
+};
+} // namespace db
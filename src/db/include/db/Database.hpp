@@ -2,6 +2,8 @@
 
 #include <db/BufferPool.hpp>
 #include <db/DbFile.hpp>
+#include <db/IoScheduler.hpp>
+#include <db/TransactionManager.hpp>
 #include <memory>
 
 /**
@@ -44,7 +46,9 @@
 namespace db {
 class Database {
   std::unordered_map<std::string,std::unique_ptr<DbFile>, std::hash<std::string>> data;
+  IoScheduler ioScheduler;
   BufferPool bufferPool;
+  TransactionManager transactionManager{bufferPool};
 
   Database() = default;
 
@@ -62,6 +66,18 @@ public:
    */
   BufferPool &getBufferPool();
 
+  /**
+   * @brief Provides access to the IoScheduler that every page read and write goes through.
+   * @return The I/O scheduler
+   */
+  IoScheduler &getIoScheduler();
+
+  /**
+   * @brief Provides access to the TransactionManager that versions the tuples of the BufferPool.
+   * @return The transaction manager
+   */
+  TransactionManager &getTransactionManager();
+
   /**
    * @brief Adds a new file to the Database.
    * @param file The file to add.
@@ -1,9 +1,13 @@
 #pragma once
 
 #include <db/types.hpp>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace db {
+class PageSummary;
+class TupleDesc;
 
 /**
  * @brief Represents a database file.
@@ -13,43 +17,122 @@ namespace db {
  */
 class DbFile {
   const std::string name;
+  const size_t pageSize;
+  mutable size_t numPages;
   mutable std::vector<size_t> reads;
   mutable std::vector<size_t> writes;
+  mutable std::mutex bookkeeping;
+  mutable std::mutex summaryLatch;
+  std::shared_ptr<PageSummary> summary;
+
+protected:
+  /**
+   * @brief Updates the page summary, if any, with a page that was written to the file.
+   * @note Subclasses that override writePage call this for every page they write.
+   */
+  void summarizePage(std::span<const char> page, size_t id) const;
+
+  /**
+   * @brief Extends the number of pages of the file to at least numPages.
+   * @note Subclasses that override writePage call this instead of DbFile::writePage, which also logs the write in
+   * getWrites.
+   */
+  void extendTo(size_t numPages) const;
 
 public:
   /**
    * @brief Construct a new Db File object with the specified file name and tuple descriptor
    * @param The name of the file to be opened or created.
+   * @param pageSize The size of every page of the file. It must be a power of two between `DEFAULT_PAGE_SIZE`
+   * and `MAX_PAGE_SIZE`.
    * @throws std::runtime_error if the file cannot be opened or if the `fstat` system call fails.
+   * @throws std::invalid_argument if the page size is not supported.
    * @note This method calculates the number of pages in the file by dividing the file size (in bytes)
-   * by the `DEFAULT_PAGE_SIZE`.
+   * by the page size.
    */
-  explicit DbFile(const std::string &name);
+  explicit DbFile(const std::string &name, size_t pageSize = DEFAULT_PAGE_SIZE);
 
   /**
    * @brief closes the file descriptor.
    */
-  virtual ~DbFile() = default;
+  virtual ~DbFile();
 
   const std::string &getName() const;
 
+  size_t getPageSize() const;
+
+  /**
+   * @brief Returns the number of pages in the file.
+   * @note Writing a page past the end of the file extends it.
+   */
+  virtual size_t getNumPages() const;
+
+  /**
+   * @brief Returns the ids of the pages read so far.
+   * @note Only the in-memory DbFile logs its I/O, subclasses that store pages leave the log empty.
+   */
   const std::vector<size_t> &getReads() const;
 
+  /**
+   * @brief Returns the ids of the pages written so far.
+   * @note Only the in-memory DbFile logs its I/O, subclasses that store pages leave the log empty.
+   */
   const std::vector<size_t> &getWrites() const;
 
   /**
    * @brief Read a page from the file.
-   * @param page The page to read into.
+   * @param page The page to read into. Its size is the page size of the file.
    * @param id The page number of the page to be read. It determines the offset within the file.
    */
-  virtual void readPage(Page &page, size_t id) const;
+  virtual void readPage(std::span<char> page, size_t id) const;
+
+  /**
+   * @brief Read consecutive pages from the file in one request.
+   * @param pages The pages to read into. Its size is a multiple of the page size of the file.
+   * @param id The page number of the first page. It determines the offset in the file.
+   * @note The default implementation calls readPage for every page, in file order.
+   */
+  virtual void readPages(std::span<char> pages, size_t id) const;
 
   /**
    * @brief Write a page to the file.
-   * @param page The page to write.
+   * @param page The page to write. Its size is the page size of the file.
    * @param id The page number of the page to which the data will be written.
    * It determines the offset in the file.
    */
-  virtual void writePage(const Page &page, size_t id) const;
+  virtual void writePage(std::span<const char> page, size_t id) const;
+
+  /**
+   * @brief Write consecutive pages to the file in one request.
+   * @param pages The pages to write. Its size is a multiple of the page size of the file.
+   * @param id The page number of the first page. It determines the offset in the file.
+   * @note The default implementation calls writePage for every page, in file order.
+   */
+  virtual void writePages(std::span<const char> pages, size_t id) const;
+
+  /**
+   * @brief Returns a page that is already resident in memory outside of the BufferPool.
+   * @param id The page number of the page.
+   * @return A view of the page, or an empty span if the file does not expose its pages directly.
+   * @note Pages returned by this method are neither cached in nor evicted by the BufferPool.
+   */
+  virtual std::span<const char> mappedPage(size_t id) const;
+
+  /**
+   * @brief Builds a PageSummary of the tuple pages of the file, which writePage keeps up to date from then on.
+   * @param td The schema of the tuples of the file.
+   * @param zoneColumns The columns with a zone map.
+   * @param bloomColumns The columns with a Bloom filter.
+   * @note The dirty pages of the file in the BufferPool are flushed first, then the pages are read once with
+   * readPage. Writes that complete during the build wait for the new summary and are added to it. Any previous
+   * summary is replaced.
+   */
+  void summarize(const TupleDesc &td, const std::vector<size_t> &zoneColumns, const std::vector<size_t> &bloomColumns);
+
+  /**
+   * @brief Returns the page summary of the file, or nullptr if summarize has not been called.
+   * @note The summary stays valid while it is held, even if summarize replaces it.
+   */
+  std::shared_ptr<const PageSummary> getSummary() const;
 };
 } // namespace db
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <db/Tuple.hpp>
+#include <thread>
+
+namespace db {
+constexpr size_t DEFAULT_SORT_GRANT = 4 << 20;
+
+/**
+ * @brief Pages per write of a run or of the output of a merge.
+ */
+constexpr size_t SORT_BATCH_PAGES = 8;
+
+/**
+ * @brief What a sort did: the number of sorted runs it generated and the number of merge passes over them.
+ */
+struct SortStats {
+  size_t runs;
+  size_t mergePasses;
+};
+
+/**
+ * @brief Sorts the tuple pages of a file on one column, in ascending order, within a fixed memory grant.
+ * @details The sort has two phases.
+ * Run generation: several threads read the input through their own ScanRing, so the working set of the
+ * BufferPool is left alone, each into its share of the grant. Each full share is sorted in memory and written to
+ * a TempDbFile as a sorted run. INT and DOUBLE keys are mapped to order-preserving 64-bit integers and sorted
+ * with a radix sort; CHAR keys are compared with std::sort.
+ * Merge: up to fan-in runs are merged at a time with a loser tree, so picking the next tuple takes log2(fan-in)
+ * comparisons. Each run is read into two page buffers of its own, outside the BufferPool, and the next page of a
+ * run is read ahead as a Prefetch request of the IoScheduler while the current one is merged. Runs are read once
+ * and then removed, so caching them in pool frames would only evict other pages: the read-ahead bypasses the pool
+ * and its buffers are counted against the grant instead. The fan-in is what the grant allows at two pages per run,
+ * and passes repeat until one run is left, which is written to the output.
+ * @note The input and the output must be in the Database. Runs are added to the Database while they are merged
+ * and removed afterwards. They are named after the output (output.run0, output.run1, ...), and the name of a
+ * merged run is given to the next run, so repeated sorts do not mint new file names. The catalog must not be
+ * changed while a sort runs.
+ */
+class ExternalSort {
+  const TupleDesc td;
+  const size_t column;
+  const size_t memoryGrant;
+  const size_t threads;
+
+public:
+  /**
+   * @brief Construct a sort of tuples of a schema on one column.
+   * @param td The schema of the tuples.
+   * @param column The column to sort on.
+   * @param memoryGrant The memory the sort may use for tuples and page buffers, in bytes.
+   * @param threads The number of threads that generate runs.
+   * @throws std::invalid_argument if the column does not exist or if there are no threads.
+   */
+  ExternalSort(const TupleDesc &td, size_t column, size_t memoryGrant = DEFAULT_SORT_GRANT,
+               size_t threads = std::max(1U, std::thread::hardware_concurrency()));
+
+  /**
+   * @brief Sorts the tuples of a file and appends them to another file.
+   * @param input The name of the file to sort.
+   * @param output The name of the file to append the sorted tuples to. Its pages are filled completely.
+   * @return What the sort did.
+   * @throws std::invalid_argument if the grant cannot hold the pages the sort needs.
+   */
+  SortStats sort(const std::string &input, const std::string &output) const;
+};
+} // namespace db
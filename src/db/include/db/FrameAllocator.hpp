@@ -0,0 +1,104 @@
+#pragma once
+
+#include <db/types.hpp>
+#include <map>
+#include <vector>
+
+namespace db {
+
+/**
+ * @brief The kind of pages backing the memory budget, from the most to the least TLB friendly.
+ */
+enum class PageBacking { Huge1G, Huge2M, Transparent, Regular };
+
+/**
+ * @brief How the memory budget is spread over the NUMA nodes of the host.
+ * @details `Interleave` alternates nodes page by page, `Partition` gives each node one contiguous slice of the
+ * budget, and `Local` leaves placement to the kernel's first-touch policy.
+ */
+enum class NumaPolicy { Local, Interleave, Partition };
+
+/**
+ * @brief Describes the memory that was reserved for the frames.
+ */
+struct MemoryLayout {
+  size_t capacity;
+  size_t reserved;
+  PageBacking backing;
+  NumaPolicy numaPolicy;
+  size_t numaNodes;
+};
+
+/**
+ * @brief Hands out page frames of several size classes from one shared memory budget.
+ * @details The budget is a single region that is reserved when the allocator is created, backed by the largest
+ * huge pages that the host can provide and placed on the NUMA nodes according to a NumaPolicy. Each size class (one per
+ * supported page size) keeps an arena of frames that were released and can be reused as is. Memory that is not in
+ * any arena is tracked as a set of free extents, which are coalesced when arenas are drained so that a frame of a
+ * larger class can be carved out of space previously used by smaller frames.
+ */
+class FrameAllocator {
+  char *region;
+  size_t capacity;
+  MemoryLayout layout;
+  std::map<size_t, size_t> extents;
+  std::array<std::vector<char *>, NUM_PAGE_SIZE_CLASSES> arenas;
+
+  /**
+   * @brief Carves a frame out of the free extents using first fit.
+   * @return The frame, or nullptr if no extent is large enough.
+   */
+  char *carve(size_t size);
+
+  /**
+   * @brief Returns a range of the region to the free extents, merging it with its neighbours.
+   */
+  void giveBack(size_t offset, size_t size);
+
+  /**
+   * @brief Returns the frames kept in the arenas of all other size classes to the free extents.
+   */
+  void drainArenas(size_t keep);
+
+public:
+  /**
+   * @brief Reserves the memory budget.
+   * @param capacity The budget in bytes. It is rounded down to a multiple of `DEFAULT_PAGE_SIZE`.
+   * @param numaPolicy The placement of the budget on multi-socket hosts.
+   * @throws std::bad_alloc if the memory cannot be reserved.
+   * @note 1 GiB and then 2 MiB huge pages are tried first, when the budget is at least that large. If the host has
+   * none available, the region falls back to regular pages with transparent huge pages requested.
+   */
+  explicit FrameAllocator(size_t capacity, NumaPolicy numaPolicy = NumaPolicy::Interleave);
+
+  ~FrameAllocator();
+
+  FrameAllocator(const FrameAllocator &) = delete;
+
+  FrameAllocator &operator=(const FrameAllocator &) = delete;
+
+  /**
+   * @brief Returns the size of the budget in bytes.
+   */
+  size_t getCapacity() const;
+
+  /**
+   * @brief Returns how the budget was actually reserved.
+   */
+  const MemoryLayout &getLayout() const;
+
+  /**
+   * @brief Allocates a frame.
+   * @param size The page size of the frame. It must be a valid page size.
+   * @return The frame, or nullptr if the budget is exhausted and pages must be evicted first.
+   */
+  char *allocate(size_t size);
+
+  /**
+   * @brief Returns a frame to the arena of its size class.
+   * @param frame A frame previously returned by allocate.
+   * @param size The size the frame was allocated with.
+   */
+  void release(char *frame, size_t size);
+};
+} // namespace db
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <db/DbFile.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace db {
+
+/**
+ * @brief Priority classes of page I/O, from the most to the least latency sensitive.
+ */
+enum class IoClass { ForegroundRead, Prefetch, BackgroundWrite, Bulk };
+
+constexpr size_t NUM_IO_CLASSES = 4;
+
+/**
+ * @brief Default number of queued requests of each class that may be in flight at once.
+ */
+constexpr std::array<size_t, NUM_IO_CLASSES> DEFAULT_IO_DEPTHS = {4, 2, 2, 1};
+
+/**
+ * @brief Default time after submission by which a queued request of each class should complete.
+ */
+constexpr std::array<std::chrono::microseconds, NUM_IO_CLASSES> DEFAULT_IO_DEADLINES = {
+    std::chrono::milliseconds(1), std::chrono::milliseconds(10), std::chrono::milliseconds(100),
+    std::chrono::seconds(1)};
+
+/**
+ * @brief Most pages that adjacent requests are merged into.
+ */
+constexpr size_t MAX_IO_MERGE_PAGES = 64;
+
+/**
+ * @brief Number of buckets of the latency histogram. Bucket i counts latencies under 2^i microseconds.
+ */
+constexpr size_t IO_LATENCY_BUCKETS = 32;
+
+/**
+ * @brief Metrics of one I/O class. Latency runs from submission to completion, so it includes the time queued.
+ */
+struct IoClassStats {
+  size_t requests;
+  size_t dispatches;
+  size_t pages;
+  std::chrono::nanoseconds totalLatency;
+  std::chrono::nanoseconds maxLatency;
+  std::array<size_t, IO_LATENCY_BUCKETS> histogram;
+
+  /**
+   * @brief Returns an upper bound of the given percentile of the latency, e.g. 0.99 for the tail latency.
+   */
+  std::chrono::microseconds percentile(double p) const;
+};
+
+/**
+ * @brief Schedules the page reads and writes of the database by priority class.
+ * @details Synchronous requests (read, write) run on the calling thread: a foreground miss never waits behind
+ * other I/O in a queue. Asynchronous requests (submitRead, submitWrite) are queued per class and run by a pool of
+ * worker threads. A worker picks the queued request with the earliest deadline among the classes that are under
+ * their queue depth limit, so a class cannot take over the device, and background work whose deadline has passed
+ * still gets its turn. Before a request is dispatched, queued requests of the same class and direction that extend
+ * it on either side in the same file are merged into it, up to MAX_IO_MERGE_PAGES, and issued as one readPages or
+ * writePages call. Writes of the same page complete in the order they were submitted: a write waits at the head of
+ * its queue while it overlaps a write in flight or one queued before it, so a newer copy of a page is never
+ * overwritten by an older one.
+ * @note Depth limits apply to queued requests only. Every request, synchronous or not, is counted in the metrics
+ * of its class.
+ */
+class IoScheduler {
+  struct Request {
+    const DbFile *file;
+    bool write;
+    size_t id;
+    std::span<char> pages;
+    uint64_t seq;
+    std::chrono::steady_clock::time_point submitted;
+    std::chrono::steady_clock::time_point deadline;
+    std::promise<void> done;
+  };
+
+  const std::array<size_t, NUM_IO_CLASSES> depths;
+  const std::array<std::chrono::microseconds, NUM_IO_CLASSES> deadlines;
+  mutable std::mutex latch;
+  std::condition_variable cv;
+  std::array<std::deque<Request>, NUM_IO_CLASSES> queues;
+  std::array<size_t, NUM_IO_CLASSES> inFlight;
+  std::array<IoClassStats, NUM_IO_CLASSES> stats;
+  std::vector<const Request *> writing;
+  uint64_t nextSeq;
+  std::vector<std::thread> workers;
+  bool stopping;
+
+  /**
+   * @brief Body of a worker thread.
+   */
+  void work();
+
+  /**
+   * @brief Returns whether a queued request is a write that overlaps a write in flight or one submitted before it.
+   */
+  bool blocked(const Request &request) const;
+
+  /**
+   * @brief Returns the class of the next request to dispatch, or NUM_IO_CLASSES if no class may dispatch.
+   */
+  size_t pick() const;
+
+  /**
+   * @brief Removes the head of a queue, with the queued requests that can be merged with it, ordered by page.
+   */
+  std::vector<Request> take(size_t cls);
+
+  /**
+   * @brief Records a completed request. The latch must be held.
+   */
+  void record(IoClass cls, size_t pages, std::chrono::steady_clock::time_point submitted);
+
+  /**
+   * @brief Queues a request, see submitRead and submitWrite.
+   */
+  std::future<void> submit(IoClass cls, const DbFile &file, bool write, std::span<char> pages, size_t id);
+
+public:
+  /**
+   * @brief Construct a scheduler. Worker threads are started on the first asynchronous request.
+   * @param depths The queue depth limit of each class.
+   * @param deadlines The deadline of each class.
+   * @throws std::invalid_argument if every depth is 0.
+   */
+  explicit IoScheduler(const std::array<size_t, NUM_IO_CLASSES> &depths = DEFAULT_IO_DEPTHS,
+                       const std::array<std::chrono::microseconds, NUM_IO_CLASSES> &deadlines = DEFAULT_IO_DEADLINES);
+
+  /**
+   * @brief Completes the queued requests and stops the workers.
+   */
+  ~IoScheduler();
+
+  IoScheduler(const IoScheduler &) = delete;
+
+  IoScheduler &operator=(const IoScheduler &) = delete;
+
+  /**
+   * @brief Reads consecutive pages on the calling thread.
+   */
+  void read(IoClass cls, const DbFile &file, std::span<char> pages, size_t id);
+
+  /**
+   * @brief Writes consecutive pages on the calling thread.
+   */
+  void write(IoClass cls, const DbFile &file, std::span<const char> pages, size_t id);
+
+  /**
+   * @brief Queues a read of consecutive pages.
+   * @param pages The buffer to read into. It must stay valid until the request completes.
+   * @return A future that is ready when the request has completed, and holds its error if it failed.
+   * @throws std::invalid_argument if the class has a depth of 0.
+   */
+  std::future<void> submitRead(IoClass cls, const DbFile &file, std::span<char> pages, size_t id);
+
+  /**
+   * @brief Queues a write of consecutive pages.
+   * @param pages The buffer to write from. It must stay valid and unchanged until the request completes.
+   * @return A future that is ready when the request has completed, and holds its error if it failed.
+   * @throws std::invalid_argument if the class has a depth of 0.
+   */
+  std::future<void> submitWrite(IoClass cls, const DbFile &file, std::span<const char> pages, size_t id);
+
+  /**
+   * @brief Returns the metrics of a class.
+   */
+  IoClassStats getStats(IoClass cls) const;
+};
+} // namespace db
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <db/DbFile.hpp>
+
+namespace db {
+
+/**
+ * @brief Represents a read-only database file whose pages are memory-mapped.
+ * @details The whole file is mapped into the address space once, and the read-only accessors of the BufferPool
+ * (viewPage, fetchRead) hand out views into the mapping instead of copying each page into one of its frames. The
+ * kernel page cache owns these pages, so the BufferPool neither counts them against its capacity nor evicts them.
+ * @note Pages of a `MmapDbFile` must not be modified. `writePage` throws, and `BufferPool::markDirty` and
+ * `BufferPool::fetchWrite` reject them.
+ */
+class MmapDbFile : public DbFile {
+public:
+  /**
+   * @brief Access pattern hints forwarded to the kernel through `madvise`.
+   */
+  enum class Access { Normal, Sequential, Random, WillNeed };
+
+private:
+  int fd;
+  char *data;
+  size_t numPages;
+
+public:
+  /**
+   * @brief Opens and maps an existing file.
+   * @param name The name of the file to be mapped. It is also the name of the file in the catalog.
+   * @param access The initial access pattern hint for the mapping.
+   * @param pageSize The size of every page of the file.
+   * @throws std::runtime_error if the file cannot be opened, if the `fstat` system call fails or if the file cannot
+   * be mapped.
+   * @note A trailing partial page is not mapped.
+   */
+  explicit MmapDbFile(const std::string &name, Access access = Access::Normal, size_t pageSize = DEFAULT_PAGE_SIZE);
+
+  /**
+   * @brief Unmaps the file and closes the file descriptor.
+   */
+  ~MmapDbFile() override;
+
+  MmapDbFile(const MmapDbFile &) = delete;
+
+  MmapDbFile &operator=(const MmapDbFile &) = delete;
+
+  /**
+   * @brief Changes the access pattern hint of the whole mapping.
+   * @param access The new access pattern hint.
+   */
+  void advise(Access access) const;
+
+  /**
+   * @brief Returns the number of mapped pages.
+   */
+  size_t getNumPages() const override;
+
+  /**
+   * @brief Copies a page out of the mapping.
+   * @throws std::out_of_range if the page is past the end of the file.
+   */
+  void readPage(std::span<char> page, size_t id) const override;
+
+  /**
+   * @throws std::logic_error always, the file is read-only.
+   */
+  void writePage(std::span<const char> page, size_t id) const override;
+
+  /**
+   * @brief Returns the page directly from the mapping, without copying it.
+   * @throws std::out_of_range if the page is past the end of the file.
+   */
+  std::span<const char> mappedPage(size_t id) const override;
+};
+} // namespace db
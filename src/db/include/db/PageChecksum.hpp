@@ -0,0 +1,68 @@
+#pragma once
+
+#include <db/types.hpp>
+#include <cstdint>
+
+namespace db {
+
+/**
+ * @brief Bytes stored before a page on disk: the LSN of the write, as a 64-bit little-endian integer.
+ */
+constexpr size_t CHECKSUM_HEADER_SIZE = 8;
+
+/**
+ * @brief Bytes stored at the end of a slot on disk: the LSN of the write again, then the CRC32C of everything
+ * before it.
+ */
+constexpr size_t CHECKSUM_TRAILER_SIZE = 12;
+
+/**
+ * @brief Default block size that sealed slots are padded to: the logical sector size, the unit in which devices
+ * write, and tear, data.
+ */
+constexpr size_t DEFAULT_CHECKSUM_BLOCK_SIZE = 512;
+
+/**
+ * @brief What verifyPage found in a sealed page.
+ * @details Empty is a slot of zeros, i.e. a page that was never written. Torn is a slot whose header and trailer
+ * carry different LSNs: only part of a write reached the disk. Corrupt is any other checksum mismatch.
+ */
+enum class PageStatus { Valid, Empty, Torn, Corrupt };
+
+/**
+ * @brief Returns the size of a page on disk once it is sealed: its header, the page and its trailer, padded to a
+ * multiple of the block size so that slots start and end on block boundaries.
+ */
+constexpr size_t sealedSize(size_t pageSize, size_t blockSize = DEFAULT_CHECKSUM_BLOCK_SIZE) {
+  return (CHECKSUM_HEADER_SIZE + pageSize + CHECKSUM_TRAILER_SIZE + blockSize - 1) / blockSize * blockSize;
+}
+
+/**
+ * @brief Computes the CRC32C (Castagnoli) of some bytes, with the SSE4.2 crc32 instruction when the CPU has it.
+ * @param crc The CRC of the preceding bytes, to checksum data in several parts.
+ */
+uint32_t crc32c(std::span<const char> data, uint32_t crc = 0);
+
+/**
+ * @brief Wraps a page in a header and a trailer that carry the LSN of the write and a CRC32C of the slot.
+ * @details The header and the page are at the start of the slot and the trailer at its very end, so they fall in
+ * the first and the last block of the slot. The padding in between is zeroed.
+ * @param page The page to seal.
+ * @param lsn The LSN of the write. It must not be 0, which marks pages that were never written.
+ * @param slot The bytes to write to disk, usually sealedSize(page.size(), blockSize) of them.
+ * @throws std::invalid_argument if the LSN is 0 or if the slot is too small for the page.
+ */
+void sealPage(std::span<const char> page, uint64_t lsn, std::span<char> slot);
+
+/**
+ * @brief Checks a slot sealed by sealPage.
+ * @return The status of the slot. The page itself follows the header at the start of the slot.
+ */
+PageStatus verifyPage(std::span<const char> slot);
+
+/**
+ * @brief Returns the larger of the two LSNs of a slot sealed by sealPage, whether or not the slot verifies.
+ * @throws std::invalid_argument if the slot is too small to hold a sealed page.
+ */
+uint64_t slotLsn(std::span<const char> slot);
+} // namespace db
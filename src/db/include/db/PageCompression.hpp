@@ -0,0 +1,25 @@
+#pragma once
+
+#include <db/types.hpp>
+#include <vector>
+
+namespace db {
+
+/**
+ * @brief Compresses a page with a byte-oriented LZ77 scheme tuned for speed over ratio.
+ * @details The output is a sequence of tokens. A token byte below 0x80 is followed by that many plus one literal
+ * bytes. Any other token byte copies (token & 0x7F) + 4 bytes from a 16-bit little-endian distance back in the
+ * output. Pages are at most `MAX_PAGE_SIZE` bytes, so every distance fits.
+ * @param page The page to compress.
+ * @return The compressed bytes.
+ */
+std::vector<char> compressPage(std::span<const char> page);
+
+/**
+ * @brief Restores a page compressed by compressPage.
+ * @param compressed The compressed bytes.
+ * @param page The page to restore into. Its size must be the size of the original page.
+ * @throws std::runtime_error if the compressed bytes are corrupt or do not decompress to exactly one page.
+ */
+void decompressPage(std::span<const char> compressed, std::span<char> page);
+} // namespace db
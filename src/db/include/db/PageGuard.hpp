@@ -0,0 +1,98 @@
+#pragma once
+
+#include <db/BufferPool.hpp>
+
+namespace db {
+
+/**
+ * @brief Gives shared, read-only access to a page of the BufferPool.
+ * @details The page is pinned and a shared latch is held on it for the lifetime of the guard, so it cannot be
+ * evicted or modified through a WritePageGuard until the guard is released or destroyed. Guards are movable and
+ * hold no more than the pin and the latch.
+ * @note A guard must not outlive the BufferPool it was obtained from.
+ */
+class ReadPageGuard {
+  friend class BufferPool;
+
+  BufferPool *pool;
+  uint32_t index;
+  std::span<const char> frame;
+
+  ReadPageGuard(BufferPool *pool, uint32_t index, std::span<const char> frame);
+
+public:
+  /**
+   * @brief Creates an empty guard.
+   */
+  ReadPageGuard();
+
+  ReadPageGuard(ReadPageGuard &&other) noexcept;
+
+  ReadPageGuard &operator=(ReadPageGuard &&other) noexcept;
+
+  ReadPageGuard(const ReadPageGuard &) = delete;
+
+  ReadPageGuard &operator=(const ReadPageGuard &) = delete;
+
+  ~ReadPageGuard();
+
+  /**
+   * @brief Returns the contents of the page. Its size is the page size of the file.
+   */
+  std::span<const char> getData() const;
+
+  /**
+   * @brief Returns the page.
+   * @throws std::logic_error if the page size of the file is not `DEFAULT_PAGE_SIZE`.
+   */
+  const Page &getPage() const;
+
+  /**
+   * @brief Releases the latch and the pin early. The guard is empty afterwards.
+   */
+  void release();
+};
+
+/**
+ * @brief Gives exclusive access to a page of the BufferPool.
+ * @details The page is pinned and an exclusive latch is held on it for the lifetime of the guard. The page is
+ * marked dirty when the guard is released, so callers do not have to call BufferPool::markDirty.
+ * @note A guard must not outlive the BufferPool it was obtained from.
+ */
+class WritePageGuard {
+  friend class BufferPool;
+
+  BufferPool *pool;
+  uint32_t index;
+  std::span<char> frame;
+
+  WritePageGuard(BufferPool *pool, uint32_t index, std::span<char> frame);
+
+public:
+  WritePageGuard(WritePageGuard &&other) noexcept;
+
+  WritePageGuard &operator=(WritePageGuard &&other) noexcept;
+
+  WritePageGuard(const WritePageGuard &) = delete;
+
+  WritePageGuard &operator=(const WritePageGuard &) = delete;
+
+  ~WritePageGuard();
+
+  /**
+   * @brief Returns the contents of the page. Its size is the page size of the file.
+   */
+  std::span<char> getData() const;
+
+  /**
+   * @brief Returns the page.
+   * @throws std::logic_error if the page size of the file is not `DEFAULT_PAGE_SIZE`.
+   */
+  Page &getPage() const;
+
+  /**
+   * @brief Marks the page dirty and releases the latch and the pin early. The guard is empty afterwards.
+   */
+  void release();
+};
+} // namespace db
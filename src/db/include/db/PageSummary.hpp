@@ -0,0 +1,79 @@
+#pragma once
+
+#include <db/Tuple.hpp>
+#include <mutex>
+
+namespace db {
+
+/**
+ * @brief Number of 32-bit words of a Bloom filter block. A block is 256 bits, the width of an AVX2 register.
+ */
+constexpr size_t BLOOM_BLOCK_WORDS = 8;
+
+/**
+ * @brief Default size of the Bloom filters, in bits per tuple of a full page. 10 bits give about 1% false positives.
+ */
+constexpr size_t DEFAULT_BLOOM_BITS_PER_KEY = 10;
+
+/**
+ * @brief Per-page metadata of the tuple pages of a file, used to skip pages that cannot match a predicate.
+ * @details Zone map columns (INT or DOUBLE) keep the minimum and maximum value of each page. Bloom filter columns
+ * (any type) keep one split-block Bloom filter per page: a key sets one bit in each of the 8 words of one 256-bit
+ * block, so a probe is a single block compare, done with AVX2 when the CPU supports it. Both answer with a
+ * superset of the pages that contain a match: a page that is not a candidate never has to be read.
+ * @note The summary describes the pages as they were last written to the file. Dirty pages of the BufferPool are
+ * only taken into account once they are flushed.
+ */
+class PageSummary {
+  struct Zone {
+    double min;
+    double max;
+  };
+
+  const TupleDesc td;
+  const std::vector<size_t> zoneColumns;
+  const std::vector<size_t> bloomColumns;
+  const size_t bloomBlocks;
+  mutable std::mutex latch;
+  size_t numPages;
+  std::vector<std::vector<Zone>> zones;
+  std::vector<std::vector<uint32_t>> blooms;
+
+public:
+  /**
+   * @brief Construct an empty summary.
+   * @param td The schema of the tuples of the file.
+   * @param zoneColumns The columns with a zone map.
+   * @param bloomColumns The columns with a Bloom filter.
+   * @param pageSize The page size of the file.
+   * @param bitsPerKey The size of the Bloom filter of a page, in bits per tuple of a full page. It is rounded up to
+   * whole blocks.
+   * @throws std::invalid_argument if a column does not exist, if a zone map column is a CHAR column or if
+   * bitsPerKey is 0.
+   */
+  PageSummary(const TupleDesc &td, const std::vector<size_t> &zoneColumns, const std::vector<size_t> &bloomColumns,
+              size_t pageSize, size_t bitsPerKey = DEFAULT_BLOOM_BITS_PER_KEY);
+
+  const TupleDesc &getTupleDesc() const;
+
+  size_t getNumPages() const;
+
+  /**
+   * @brief Recomputes the metadata of a page from its contents.
+   */
+  void update(std::span<const char> page, size_t id);
+
+  /**
+   * @brief Returns the pages that may hold a tuple whose column is between low and high, inclusive.
+   * @throws std::invalid_argument if the column has no zone map.
+   */
+  std::vector<size_t> candidatePages(size_t column, double low, double high) const;
+
+  /**
+   * @brief Returns the pages that may hold a tuple whose column is equal to a value.
+   * @details The zone map and the Bloom filter of the column are both used when present.
+   * @throws std::invalid_argument if the column has neither, or if the value is not of the type of the column.
+   */
+  std::vector<size_t> candidatePages(size_t column, const field_t &value) const;
+};
+} // namespace db
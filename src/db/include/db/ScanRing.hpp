@@ -0,0 +1,71 @@
+#pragma once
+
+#include <db/BufferPool.hpp>
+#include <db/PageGuard.hpp>
+#include <db/Tuple.hpp>
+
+namespace db {
+
+/**
+ * @brief A private ring of frames used by one bulk scan.
+ * @details Pages read through a ScanRing that are not already in the BufferPool are loaded into the ring's own
+ * frames, which are recycled in FIFO order once the ring is full, instead of being inserted into the LRU list. A
+ * large sequential scan therefore displaces at most the ring's size worth of pages from the pool. Pages that are
+ * already resident are used where they are, and a ring page that is requested through BufferPool::getPage joins
+ * the LRU list. When the ScanRing is destroyed, its frames are handed to the pool as its least recently used pages.
+ * @note A ScanRing must not outlive the BufferPool it was obtained from.
+ */
+class ScanRing {
+  friend class BufferPool;
+
+  BufferPool *pool;
+  uint16_t id;
+
+  ScanRing(BufferPool *pool, uint16_t id);
+
+public:
+  ScanRing(ScanRing &&other) noexcept;
+
+  ScanRing &operator=(ScanRing &&other) noexcept;
+
+  ScanRing(const ScanRing &) = delete;
+
+  ScanRing &operator=(const ScanRing &) = delete;
+
+  /**
+   * @brief Ends the scan and releases the ring.
+   */
+  ~ScanRing();
+
+  /**
+   * @brief Returns the page with the specified page id, reading it into the ring if it is not in the pool.
+   * @throws std::logic_error if the page size of the file is not `DEFAULT_PAGE_SIZE`.
+   */
+  Page &getPage(const PageId &pid);
+
+  /**
+   * @brief Returns the page with the specified page id, for files of any page size.
+   * @note Like BufferPool::getPage, the page is not pinned: other misses of the pool may recycle its frame. Use
+   * fetchRead when other threads use the pool at the same time.
+   */
+  std::span<char> getPageSpan(const PageId &pid);
+
+  /**
+   * @brief Returns the page with the specified page id through the ring, pinned and under a shared latch.
+   * @details The ring does not recycle the frame while the guard is held. It grows past its size instead when every
+   * one of its frames is held.
+   */
+  ReadPageGuard fetchRead(const PageId &pid);
+
+  /**
+   * @brief Reads the pages of a file that may hold a tuple whose column is equal to a value, in order.
+   * @details The pages are picked with the PageSummary of the file (DbFile::summarize), so pages that cannot match
+   * are never read. Without a summary every page of the file is read.
+   * @param visit Called with the id and the contents of every page read, while the page is pinned.
+   * @throws std::invalid_argument if the file has a summary and the column has neither a zone map nor a Bloom
+   * filter in it.
+   */
+  void scanMatching(const std::string &file, size_t column, const field_t &value,
+                    const std::function<void(size_t, std::span<const char>)> &visit);
+};
+} // namespace db
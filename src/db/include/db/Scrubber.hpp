@@ -0,0 +1,113 @@
+#pragma once
+
+#include <db/ChecksummedDbFile.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace db {
+
+/**
+ * @brief Default pause between two pages of a scrub, which keeps it from competing with queries for the disk.
+ */
+constexpr std::chrono::microseconds DEFAULT_SCRUB_PAUSE = std::chrono::microseconds(100);
+
+/**
+ * @brief Default pause between two passes of a scrub.
+ */
+constexpr std::chrono::milliseconds DEFAULT_SCRUB_INTERVAL = std::chrono::hours(1);
+
+/**
+ * @brief A page that failed verification during a scrub.
+ */
+struct BadPage {
+  std::string file;
+  size_t page;
+  PageStatus status;
+
+  bool operator==(const BadPage &) const = default;
+};
+
+/**
+ * @brief What a Scrubber has done since it started.
+ */
+struct ScrubStats {
+  size_t passes;
+  size_t pages;
+  size_t torn;
+  size_t corrupt;
+  size_t unreadable;
+};
+
+/**
+ * @brief Verifies the checksums of some files in the background, so latent corruption is found before a query
+ * reads the page.
+ * @details A background thread walks the pages of every file in order with ChecksummedDbFile::checkPage, which
+ * reads the sealed slot into a buffer of its own: the BufferPool is not involved, so scrubbing neither evicts the
+ * working set nor takes frames. A page that fails is checked again after a pause before it is reported, since a
+ * write of that page may have been in progress. The bad pages of the last complete pass are kept. Pages that could
+ * not be read at all, e.g. because of an I/O error, are reported apart from them: their contents are unknown, so
+ * they are neither torn nor corrupt.
+ * @note The files must outlive the Scrubber.
+ */
+class Scrubber {
+  const std::vector<const ChecksummedDbFile *> files;
+  const std::chrono::microseconds pause;
+  const std::chrono::milliseconds interval;
+  mutable std::mutex mutex;
+  std::condition_variable cv;
+  ScrubStats stats;
+  std::vector<BadPage> badPages;
+  std::vector<PageId> unreadablePages;
+  bool stopping;
+  std::thread thread;
+
+  /**
+   * @brief Body of the scrub thread.
+   */
+  void run();
+
+  /**
+   * @brief Waits for a duration, or until the Scrubber is stopped.
+   * @return True if the Scrubber is stopping.
+   */
+  bool sleep(std::unique_lock<std::mutex> &lock, std::chrono::microseconds duration);
+
+public:
+  /**
+   * @brief Starts scrubbing files.
+   * @param files The files to scrub, in order.
+   * @param pause The pause between two pages.
+   * @param interval The pause between two passes.
+   */
+  explicit Scrubber(std::vector<const ChecksummedDbFile *> files, std::chrono::microseconds pause = DEFAULT_SCRUB_PAUSE,
+                    std::chrono::milliseconds interval = DEFAULT_SCRUB_INTERVAL);
+
+  /**
+   * @brief Stops scrubbing, in the middle of a pass if needed.
+   */
+  ~Scrubber();
+
+  Scrubber(const Scrubber &) = delete;
+
+  Scrubber &operator=(const Scrubber &) = delete;
+
+  ScrubStats getStats() const;
+
+  /**
+   * @brief Returns the pages that failed verification in the last complete pass.
+   */
+  std::vector<BadPage> getBadPages() const;
+
+  /**
+   * @brief Returns the pages that could not be read in the last complete pass.
+   */
+  std::vector<PageId> getUnreadablePages() const;
+
+  /**
+   * @brief Waits until a number of passes have completed since the Scrubber started.
+   */
+  void awaitPasses(size_t passes);
+};
+} // namespace db
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <db/PageGuard.hpp>
+
+namespace db {
+
+/**
+ * @brief A cursor over every page of a file that shares its disk reads with concurrent scans of the same file.
+ * @details All SharedScans of one file form a group that reads through a single ScanRing. A scan that starts
+ * while others are in progress begins at the page the group read last instead of page 0, so it rides along with
+ * them and finds their pages in the ring. Each scan wraps around at the end of the file and stops after visiting
+ * every page once. N scans that run in step thus cost about one pass over the file.
+ * @note A SharedScan must not outlive the BufferPool it was obtained from.
+ */
+class SharedScan {
+  friend class BufferPool;
+
+  BufferPool *pool;
+  std::string file;
+  size_t start;
+  size_t numPages;
+  size_t visited;
+
+  SharedScan(BufferPool *pool, const std::string &file, size_t start, size_t numPages);
+
+public:
+  SharedScan(SharedScan &&other) noexcept;
+
+  SharedScan &operator=(SharedScan &&other) noexcept;
+
+  SharedScan(const SharedScan &) = delete;
+
+  SharedScan &operator=(const SharedScan &) = delete;
+
+  /**
+   * @brief Leaves the group. The group's ring is released with its last scan.
+   */
+  ~SharedScan();
+
+  /**
+   * @brief Returns the page number at which this scan started.
+   */
+  size_t getStart() const;
+
+  /**
+   * @brief Returns whether every page of the file has been visited.
+   */
+  bool done() const;
+
+  /**
+   * @brief Advances to the next page.
+   * @return The page number and a guard on the page, or an empty guard once every page has been visited. The
+   * page stays pinned and latched for as long as the guard is held.
+   */
+  std::pair<size_t, ReadPageGuard> next();
+};
+} // namespace db
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <db/Tuple.hpp>
+#include <algorithm>
+#include <string_view>
+#include <tuple>
+
+namespace db {
+
+/**
+ * @brief Maps a C++ field type of a StaticTupleDesc to its runtime type, serialized size and accessor type.
+ */
+template <typename T> struct FieldTraits;
+
+template <> struct FieldTraits<int> {
+  static constexpr type_t type = INT;
+  static constexpr size_t size = INT_SIZE;
+  using value_type = int;
+};
+
+template <> struct FieldTraits<double> {
+  static constexpr type_t type = DOUBLE;
+  static constexpr size_t size = DOUBLE_SIZE;
+  using value_type = double;
+};
+
+template <> struct FieldTraits<std::string> {
+  static constexpr type_t type = CHAR;
+  static constexpr size_t size = CHAR_SIZE;
+  using value_type = std::string_view;
+};
+
+/**
+ * @brief Describes a schema that is known at compile time.
+ * @details The field offsets, the tuple length and the accessors are computed by the compiler, so reading a field
+ * is a single load at a constant offset instead of a switch on its type, and scans and filters are instantiated
+ * for each schema and predicate. The serialized bytes and the tuple page layout are the same as those of the
+ * equivalent TupleDesc (see runtime()), so both can be used on the same pages.
+ * @tparam Fields The field types, each of int, double or std::string (a CHAR field, read as a std::string_view
+ * into the page).
+ */
+template <typename... Fields> class StaticTupleDesc {
+  static_assert(sizeof...(Fields) > 0, "A tuple needs at least one field");
+
+  static constexpr std::array<size_t, sizeof...(Fields)> computeOffsets() {
+    std::array<size_t, sizeof...(Fields)> offsets{};
+    size_t offset = 0;
+    size_t i = 0;
+    ((offsets[i++] = offset, offset += FieldTraits<Fields>::size), ...);
+    return offsets;
+  }
+
+  template <size_t... Is>
+  static void serialize(char *data, std::index_sequence<Is...>,
+                        const std::tuple<typename FieldTraits<Fields>::value_type...> &values) {
+    (set<Is>(data, std::get<Is>(values)), ...);
+  }
+
+  template <size_t... Is> static Tuple deserialize(const char *data, std::index_sequence<Is...>) {
+    return Tuple({field_t(std::in_place_type<Fields>, get<Is>(data))...});
+  }
+
+public:
+  static constexpr size_t NUM_FIELDS = sizeof...(Fields);
+
+  static constexpr std::array<size_t, NUM_FIELDS> offsets = computeOffsets();
+
+  static constexpr size_t length = (FieldTraits<Fields>::size + ...);
+
+  template <size_t I> using value_type = typename FieldTraits<std::tuple_element_t<I, std::tuple<Fields...>>>::value_type;
+
+  /**
+   * @brief A serialized tuple on a page.
+   */
+  class Row {
+    const char *data;
+
+  public:
+    explicit Row(const char *data) : data(data) {}
+
+    template <size_t I> value_type<I> get() const { return StaticTupleDesc::get<I>(data); }
+  };
+
+  /**
+   * @brief Returns the equivalent runtime schema.
+   */
+  static TupleDesc runtime() { return TupleDesc({FieldTraits<Fields>::type...}); }
+
+  /**
+   * @brief Reads field I of a serialized tuple.
+   */
+  template <size_t I> static value_type<I> get(const char *data) {
+    const char *field = data + offsets[I];
+    if constexpr (std::is_same_v<value_type<I>, std::string_view>) {
+      return std::string_view(field, strnlen(field, CHAR_SIZE));
+    } else {
+      value_type<I> value;
+      std::memcpy(&value, field, sizeof(value));
+      return value;
+    }
+  }
+
+  /**
+   * @brief Writes field I of a serialized tuple.
+   * @throws std::invalid_argument if a string does not fit in CHAR_SIZE.
+   */
+  template <size_t I> static void set(char *data, value_type<I> value) {
+    char *field = data + offsets[I];
+    if constexpr (std::is_same_v<value_type<I>, std::string_view>) {
+      if (value.size() > CHAR_SIZE) {
+        throw std::invalid_argument("String does not fit in a CHAR field");
+      }
+      std::memcpy(field, value.data(), value.size());
+      std::memset(field + value.size(), 0, CHAR_SIZE - value.size());
+    } else {
+      std::memcpy(field, &value, sizeof(value));
+    }
+  }
+
+  /**
+   * @brief Writes a tuple to data, which must hold length bytes.
+   * @throws std::invalid_argument if a string does not fit in CHAR_SIZE.
+   */
+  static void serialize(char *data, typename FieldTraits<Fields>::value_type... values) {
+    serialize(data, std::index_sequence_for<Fields...>(), std::make_tuple(values...));
+  }
+
+  static Tuple deserialize(const char *data) { return deserialize(data, std::index_sequence_for<Fields...>()); }
+
+  static constexpr size_t pageCapacity(size_t pageSize) { return (pageSize - TUPLE_PAGE_HEADER) / length; }
+
+  /**
+   * @see TupleDesc::tupleCount
+   */
+  static size_t tupleCount(std::span<const char> page) {
+    return std::min<size_t>(getTupleCount(page), pageCapacity(page.size()));
+  }
+
+  /**
+   * @brief Appends a tuple to a tuple page.
+   * @return False if the page is full, or if its tuple count is past the capacity of the page.
+   */
+  static bool appendTuple(std::span<char> page, typename FieldTraits<Fields>::value_type... values) {
+    uint32_t count = getTupleCount(page);
+    if (count >= pageCapacity(page.size())) {
+      return false;
+    }
+    serialize(page.data() + TUPLE_PAGE_HEADER + count * length, values...);
+    setTupleCount(page, count + 1);
+    return true;
+  }
+
+  /**
+   * @brief Calls visit with a Row for every tuple of a tuple page, in slot order.
+   * @note A tuple count past the capacity of the page is clamped to the capacity.
+   */
+  template <typename Visit> static void scanPage(std::span<const char> page, Visit &&visit) {
+    const char *data = page.data() + TUPLE_PAGE_HEADER;
+    const size_t count = tupleCount(page);
+    for (size_t slot = 0; slot < count; slot++, data += length) {
+      visit(Row(data));
+    }
+  }
+
+  /**
+   * @brief Returns the slots of the tuples of a tuple page whose field I satisfies a predicate.
+   * @note A tuple count past the capacity of the page is clamped to the capacity.
+   */
+  template <size_t I, typename Predicate>
+  static std::vector<size_t> filter(std::span<const char> page, Predicate &&predicate) {
+    std::vector<size_t> slots;
+    const char *data = page.data() + TUPLE_PAGE_HEADER;
+    const size_t count = tupleCount(page);
+    for (size_t slot = 0; slot < count; slot++, data += length) {
+      if (predicate(get<I>(data))) {
+        slots.push_back(slot);
+      }
+    }
+    return slots;
+  }
+};
+} // namespace db
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <db/DbFile.hpp>
+
+namespace db {
+
+/**
+ * @brief Represents a scratch database file that stores its pages on disk and disappears when it is destroyed.
+ * @details The file is created in the temporary directory and unlinked right away, so it never outlives the
+ * process. Pages are read and written with pread and pwrite at their offset. It holds intermediate results such as
+ * the sorted runs of an ExternalSort.
+ */
+class TempDbFile : public DbFile {
+  int fd;
+
+public:
+  /**
+   * @brief Creates an empty scratch file.
+   * @param name The name of the file in the catalog. It is not a path.
+   * @param pageSize The size of every page of the file.
+   * @throws std::runtime_error if the file cannot be created.
+   */
+  explicit TempDbFile(const std::string &name, size_t pageSize = DEFAULT_PAGE_SIZE);
+
+  /**
+   * @brief Closes the file descriptor, which releases the storage.
+   */
+  ~TempDbFile() override;
+
+  TempDbFile(const TempDbFile &) = delete;
+
+  TempDbFile &operator=(const TempDbFile &) = delete;
+
+  /**
+   * @brief Reads a page. Pages that were never written read as zeros.
+   * @throws std::runtime_error if the read fails.
+   */
+  void readPage(std::span<char> page, size_t id) const override;
+
+  /**
+   * @brief Reads consecutive pages with a single pread. Pages that were never written read as zeros.
+   * @throws std::runtime_error if the read fails.
+   */
+  void readPages(std::span<char> pages, size_t id) const override;
+
+  /**
+   * @throws std::runtime_error if the write fails.
+   */
+  void writePage(std::span<const char> page, size_t id) const override;
+
+  /**
+   * @brief Writes consecutive pages with a single pwrite.
+   * @throws std::runtime_error if the write fails.
+   */
+  void writePages(std::span<const char> pages, size_t id) const override;
+};
+} // namespace db
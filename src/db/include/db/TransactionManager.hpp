@@ -0,0 +1,214 @@
+#pragma once
+
+#include <db/BufferPool.hpp>
+#include <db/Tuple.hpp>
+#include <set>
+
+namespace db {
+using timestamp_t = uint64_t;
+
+/**
+ * @brief Commit timestamp of a version whose writer has not committed yet.
+ */
+constexpr timestamp_t UNCOMMITTED = UINT64_MAX;
+
+/**
+ * @brief Identifies a tuple: a slot of a tuple page.
+ */
+struct TupleId {
+  PageId pid;
+  size_t slot;
+
+public:
+  bool operator==(const TupleId &) const = default;
+};
+
+/**
+ * @brief A transaction of a TransactionManager. It is owned by the caller and passed to every operation.
+ * @details It reads the snapshot of the database as of its start timestamp, plus its own writes.
+ */
+struct Transaction {
+  uint64_t id;
+  timestamp_t startTs;
+  timestamp_t commitTs;
+  std::vector<TupleId> writes;
+  bool active;
+};
+
+class TransactionGuard;
+
+/**
+ * @brief Runs transactions under snapshot isolation on the tuple pages of the BufferPool.
+ * @details Updates are made in place in the buffer pool frame, and the previous contents of the tuple are pushed
+ * on the version chain of the tuple, in an undo area kept next to the frames. Every version is stamped with the
+ * commit timestamp of its writer, so a reader that started earlier walks the chain back to the newest version
+ * that was committed before it started. Readers never wait for writers: they only hold the shared latch of the
+ * page, briefly, and old versions come from the undo area. Two transactions writing the same tuple conflict, and
+ * the second writer fails (first writer wins). collectGarbage drops the versions that no active transaction can
+ * see anymore. The undo area is a single table keyed by tuple rather than per frame: versions must survive the
+ * eviction of their page, so they are tied to the file instead, and discardFile drops them with it.
+ * @note Tuples are read and written whole: their size is the size of the span passed to read and write, and
+ * slot s of a tuple page lives at TUPLE_PAGE_HEADER + s * size.
+ */
+class TransactionManager {
+  struct Version {
+    std::vector<char> data;
+    uint64_t writer;
+    timestamp_t commitTs;
+  };
+
+  struct Chain {
+    uint64_t writer;
+    timestamp_t commitTs;
+    std::vector<Version> undo;
+  };
+
+  struct TupleIdHash {
+    size_t operator()(const TupleId &tid) const {
+      return std::hash<const PageId>()(tid.pid) ^ std::hash<size_t>()(tid.slot) * 31;
+    }
+  };
+
+  BufferPool &bufferPool;
+  mutable std::mutex latch;
+  std::unordered_map<TupleId, Chain, TupleIdHash> chains;
+  std::multiset<timestamp_t> activeSnapshots;
+  timestamp_t clock;
+  uint64_t nextId;
+  size_t undoSize;
+
+  /**
+   * @brief Removes a transaction from the active ones.
+   */
+  void finish(Transaction &txn);
+
+  /**
+   * @brief Pops the newest version of a tuple off its chain and copies it back into the page, unless the page is
+   * empty. The latch must be held.
+   */
+  void undo(const TupleId &tid, std::span<char> page);
+
+  /**
+   * @brief Throws if another transaction wrote a tuple and has not committed, or committed after txn started. The
+   * latch must be held.
+   */
+  void checkConflict(const Transaction &txn, const TupleId &tid) const;
+
+public:
+  explicit TransactionManager(BufferPool &bufferPool);
+
+  TransactionManager(const TransactionManager &) = delete;
+
+  TransactionManager &operator=(const TransactionManager &) = delete;
+
+  /**
+   * @brief Starts a transaction that sees every transaction committed so far.
+   * @note A transaction that is never committed nor aborted holds back collectGarbage. Prefer beginGuarded.
+   */
+  Transaction begin();
+
+  /**
+   * @brief Starts a transaction owned by a guard, which aborts it if it is still active when the guard goes away.
+   */
+  TransactionGuard beginGuarded();
+
+  /**
+   * @brief Commits a transaction: its writes become visible to the transactions that start afterwards.
+   * @throws std::logic_error if the transaction has already finished.
+   */
+  void commit(Transaction &txn);
+
+  /**
+   * @brief Aborts a transaction and restores the tuples it wrote.
+   * @details The transaction is finished even if a tuple cannot be restored, e.g. because its file was removed:
+   * the other tuples are restored and the first error is rethrown afterwards.
+   * @throws std::logic_error if the transaction has already finished.
+   */
+  void abort(Transaction &txn);
+
+  /**
+   * @brief Reads the version of a tuple that is visible to a transaction.
+   * @param tuple The tuple to read into. Its size is the size of the tuple.
+   * @throws std::out_of_range if the slot is not on the page.
+   * @throws std::invalid_argument if the visible version is an older one of a different size.
+   */
+  void read(const Transaction &txn, const TupleId &tid, std::span<char> tuple);
+
+  /**
+   * @brief Updates a tuple in place and keeps its previous version for older snapshots.
+   * @param tuple The new contents of the tuple. Its size is the size of the tuple.
+   * @throws std::runtime_error if another transaction wrote the tuple and either has not committed yet or committed
+   * after txn started. txn should then be aborted.
+   * @throws std::out_of_range if the slot is not on the page.
+   */
+  void write(Transaction &txn, const TupleId &tid, std::span<const char> tuple);
+
+  /**
+   * @brief Drops the versions that are older than the version visible to the oldest active transaction.
+   * @return The number of versions dropped.
+   */
+  size_t collectGarbage();
+
+  /**
+   * @brief Drops the version chains of a file.
+   * @note The file must not be written by an active transaction.
+   */
+  void discardFile(const std::string &file);
+
+  /**
+   * @brief Returns the number of bytes held by old versions in the undo area.
+   */
+  size_t getUndoSize() const;
+};
+
+/**
+ * @brief Owns a transaction of a TransactionManager and aborts it on destruction unless it was committed or
+ * aborted, so a transaction abandoned by an early return or an exception does not hold back collectGarbage.
+ * @details Guards are movable. getTransaction hands out the transaction to pass to read and write.
+ * @note A guard must not outlive the TransactionManager it was obtained from.
+ */
+class TransactionGuard {
+  friend class TransactionManager;
+
+  TransactionManager *manager;
+  Transaction txn;
+
+  TransactionGuard(TransactionManager *manager, Transaction txn);
+
+  /**
+   * @brief Aborts the transaction if it is still active, ignoring errors.
+   */
+  void abandon() noexcept;
+
+  /**
+   * @throws std::logic_error if the guard was moved from.
+   */
+  TransactionManager &getManager() const;
+
+public:
+  TransactionGuard(TransactionGuard &&other) noexcept;
+
+  TransactionGuard &operator=(TransactionGuard &&other) noexcept;
+
+  TransactionGuard(const TransactionGuard &) = delete;
+
+  TransactionGuard &operator=(const TransactionGuard &) = delete;
+
+  /**
+   * @brief Aborts the transaction if it is still active. Errors of the abort are ignored.
+   */
+  ~TransactionGuard();
+
+  Transaction &getTransaction();
+
+  /**
+   * @see TransactionManager::commit
+   */
+  void commit();
+
+  /**
+   * @see TransactionManager::abort
+   */
+  void abort();
+};
+} // namespace db
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <db/types.hpp>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+namespace db {
+
+enum type_t { INT, DOUBLE, CHAR };
+
+constexpr size_t INT_SIZE = sizeof(int);
+
+constexpr size_t DOUBLE_SIZE = sizeof(double);
+
+/**
+ * @brief Fixed size of a CHAR field. Shorter strings are padded with zeros.
+ */
+constexpr size_t CHAR_SIZE = 64;
+
+/**
+ * @brief Size of the header of a tuple page, which holds the number of tuples on the page.
+ * @details A tuple page is the header followed by the tuples, packed back to back with the length of their
+ * TupleDesc. The header is 8 bytes so that the tuples start aligned.
+ */
+constexpr size_t TUPLE_PAGE_HEADER = sizeof(uint64_t);
+
+using field_t = std::variant<int, double, std::string>;
+
+/**
+ * @brief Returns the number of tuples on a tuple page.
+ */
+inline uint32_t getTupleCount(std::span<const char> page) {
+  uint32_t count;
+  std::memcpy(&count, page.data(), sizeof(count));
+  return count;
+}
+
+/**
+ * @brief Sets the number of tuples on a tuple page.
+ */
+inline void setTupleCount(std::span<char> page, uint32_t count) { std::memcpy(page.data(), &count, sizeof(count)); }
+
+/**
+ * @brief A row of values, one per field of its schema.
+ */
+class Tuple {
+  std::vector<field_t> fields;
+
+public:
+  explicit Tuple(const std::vector<field_t> &fields);
+
+  type_t getType(size_t i) const;
+
+  size_t size() const;
+
+  const field_t &getField(size_t i) const;
+
+  bool operator==(const Tuple &) const = default;
+};
+
+/**
+ * @brief Describes the schema of the tuples of a file at runtime.
+ * @details Every access switches on the type of the field, so this is the generic path that works for any schema.
+ * Fixed schemas that are known at compile time should use StaticTupleDesc, which produces the same bytes.
+ */
+class TupleDesc {
+  std::vector<type_t> types;
+  std::vector<size_t> offsets;
+  size_t length;
+
+public:
+  /**
+   * @brief Construct a new TupleDesc with the given field types, laid out back to back in order.
+   * @throws std::invalid_argument if there are no fields.
+   */
+  explicit TupleDesc(const std::vector<type_t> &types);
+
+  bool operator==(const TupleDesc &) const = default;
+
+  size_t size() const;
+
+  type_t getType(size_t i) const;
+
+  size_t offsetOf(size_t i) const;
+
+  /**
+   * @brief Returns the serialized size of a tuple.
+   */
+  size_t getLength() const;
+
+  /**
+   * @brief Returns whether a tuple has the number and types of fields of this schema.
+   */
+  bool compatible(const Tuple &tuple) const;
+
+  /**
+   * @brief Writes a tuple to data, which must hold getLength() bytes.
+   * @throws std::invalid_argument if the tuple is not compatible or a string does not fit in CHAR_SIZE.
+   */
+  void serialize(char *data, const Tuple &tuple) const;
+
+  Tuple deserialize(const char *data) const;
+
+  /**
+   * @brief Reads one field of a serialized tuple.
+   */
+  field_t getField(const char *data, size_t i) const;
+
+  /**
+   * @brief Returns the number of tuples that fit on a tuple page.
+   */
+  size_t pageCapacity(size_t pageSize) const;
+
+  /**
+   * @brief Returns the number of tuples on a tuple page, clamped to the capacity of the page so that a damaged
+   * count never walks past its end.
+   */
+  size_t tupleCount(std::span<const char> page) const;
+
+  /**
+   * @brief Appends a tuple to a tuple page.
+   * @return False if the page is full, or if its tuple count is past the capacity of the page.
+   */
+  bool appendTuple(std::span<char> page, const Tuple &tuple) const;
+
+  /**
+   * @brief Calls visit with every tuple of a tuple page, in slot order.
+   * @note A tuple count past the capacity of the page is clamped to the capacity.
+   */
+  void scanPage(std::span<const char> page, const std::function<void(const Tuple &)> &visit) const;
+
+  /**
+   * @brief Returns the slots of the tuples of a tuple page whose field satisfies a predicate.
+   * @note A tuple count past the capacity of the page is clamped to the capacity.
+   */
+  std::vector<size_t> filter(std::span<const char> page, size_t field,
+                             const std::function<bool(const field_t &)> &predicate) const;
+};
+} // namespace db
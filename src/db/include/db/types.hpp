@@ -1,6 +1,9 @@
 #pragma once
 
 #include <array>
+#include <bit>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <variant>
@@ -17,7 +20,25 @@ public:
 
 constexpr size_t DEFAULT_PAGE_SIZE = 4096;
 
+constexpr size_t MAX_PAGE_SIZE = 65536;
+
+/**
+ * @brief Number of supported page sizes: every power of two from `DEFAULT_PAGE_SIZE` up to `MAX_PAGE_SIZE`.
+ */
+constexpr size_t NUM_PAGE_SIZE_CLASSES = std::countr_zero(MAX_PAGE_SIZE / DEFAULT_PAGE_SIZE) + 1;
+
 using Page = std::array<char, DEFAULT_PAGE_SIZE>;
+
+/**
+ * @brief Returns the size class of a page size, i.e. log2(pageSize / DEFAULT_PAGE_SIZE).
+ * @throws std::invalid_argument if the page size is not supported.
+ */
+inline size_t pageSizeClass(size_t pageSize) {
+  if (pageSize < DEFAULT_PAGE_SIZE || pageSize > MAX_PAGE_SIZE || !std::has_single_bit(pageSize)) {
+    throw std::invalid_argument("Unsupported page size " + std::to_string(pageSize));
+  }
+  return std::countr_zero(pageSize / DEFAULT_PAGE_SIZE);
+}
 } // namespace db
 
 template <> struct std::hash<const db::PageId> {
@@ -2,6 +2,8 @@
 
 #include <db/Database.hpp>
 #include <db/DbFile.hpp>
+#include <db/PageGuard.hpp>
+#include <db/ScanRing.hpp>
 
 TEST(BufferPoolTest, getPage) {
   db::Database &db = db::getDatabase();
@@ -193,6 +195,22 @@ TEST(BefferPoolTest, flushFile) {
   EXPECT_EQ(writes.size(), size / 2);
 }
 
+TEST(BufferPoolTest, flushRingPages) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  db::ScanRing ring = bufferPool.beginScan();
+  ring.getPage({name, 0});
+  bufferPool.markDirty({name, 0});
+  // every resident page belongs to the ring
+  EXPECT_TRUE(bufferPool.getResidentPages().empty());
+  bufferPool.flushFile(name);
+  EXPECT_FALSE(bufferPool.isDirty({name, 0}));
+  EXPECT_EQ(db.get(name).getWrites(), std::vector<size_t>{0});
+}
+
 TEST(BufferPoolTest, LRU) {
   db::Database &db = db::getDatabase();
   db::BufferPool &bufferPool = db.getBufferPool();
@@ -241,3 +259,74 @@ TEST(BufferPoolTest, LRU) {
     EXPECT_EQ(writes[i], size + i);
   }
 }
+
+TEST(BufferPoolTest, discardFile) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name1{"file1"};
+  std::string name2{"file2"};
+  db.add(std::make_unique<db::DbFile>(name1));
+  db.add(std::make_unique<db::DbFile>(name2));
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES / 2; i++) {
+    bufferPool.getPage({name1, i});
+    bufferPool.getPage({name2, i});
+    bufferPool.markDirty({name1, i});
+  }
+  auto file = db.remove(name1);
+  EXPECT_EQ(file->getWrites().size(), db::DEFAULT_NUM_PAGES / 2);
+  EXPECT_FALSE(bufferPool.searchFile(name1));
+  EXPECT_TRUE(bufferPool.searchFile(name2));
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES / 2; i++) {
+    EXPECT_FALSE(bufferPool.contains({name1, i}));
+    EXPECT_TRUE(bufferPool.contains({name2, i}));
+  }
+  // the freed frames are reused before any page of the remaining file is evicted
+  for (size_t i = db::DEFAULT_NUM_PAGES / 2; i < db::DEFAULT_NUM_PAGES; i++) {
+    bufferPool.getPage({name2, i});
+  }
+  EXPECT_TRUE(bufferPool.contains({name2, 0}));
+}
+
+TEST(BufferPoolTest, discardPinnedFile) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  bufferPool.getPage({name, 0});
+  db::ReadPageGuard guard = bufferPool.fetchRead({name, 1});
+  EXPECT_THROW(bufferPool.discardFile(name), std::logic_error);
+  // nothing was released
+  EXPECT_TRUE(bufferPool.contains({name, 0}));
+  EXPECT_TRUE(bufferPool.contains({name, 1}));
+  // a page number past the range of the bufferpool does not alias a resident page
+  EXPECT_FALSE(bufferPool.contains({name, (size_t{1} << 48) + 1}));
+}
+
+TEST(BufferPoolTest, fileIdReuse) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  bufferPool.enableSecondTier(db::DEFAULT_NUM_PAGES * db::DEFAULT_PAGE_SIZE);
+
+  std::string kept{"kept"};
+  db.add(std::make_unique<db::DbFile>(kept));
+  bufferPool.getPage({kept, 0});
+  // more distinct files than a 16 bit file id can tell apart, one at a time
+  for (size_t i = 0; i <= UINT16_MAX + 1; i++) {
+    std::string name = "file" + std::to_string(i);
+    db.add(std::make_unique<db::DbFile>(name));
+    bufferPool.getPage({name, 0});
+    db.remove(name);
+  }
+  EXPECT_TRUE(bufferPool.contains({kept, 0}));
+  EXPECT_FALSE(bufferPool.contains({"file0", 0}));
+
+  // a reused id does not pick up the pages of the file that had it
+  std::string last{"last"};
+  db.add(std::make_unique<db::DbFile>(last));
+  bufferPool.getPage({last, 0});
+  EXPECT_TRUE(bufferPool.contains({last, 0}));
+  EXPECT_FALSE(bufferPool.contains({last, 1}));
+  EXPECT_EQ(bufferPool.getResidentPages().size(), 2);
+}
@@ -0,0 +1,99 @@
+#include <gtest/gtest.h>
+
+#include <db/BulkAppender.hpp>
+#include <db/Database.hpp>
+
+namespace {
+class RecordingDbFile : public db::DbFile {
+public:
+  mutable std::vector<char> firstBytes;
+  mutable std::vector<size_t> requests;
+
+  using db::DbFile::DbFile;
+
+  void writePage(std::span<const char> page, size_t id) const override {
+    if (firstBytes.size() <= id) {
+      firstBytes.resize(id + 1);
+    }
+    firstBytes[id] = page[0];
+    db::DbFile::writePage(page, id);
+  }
+
+  void writePages(std::span<const char> pages, size_t id) const override {
+    requests.push_back(pages.size() / getPageSize());
+    db::DbFile::writePages(pages, id);
+  }
+};
+} // namespace
+
+TEST(BulkAppenderTest, append) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<RecordingDbFile>(name));
+  const auto &file = dynamic_cast<const RecordingDbFile &>(db.get(name));
+  constexpr size_t batchPages = 16;
+  constexpr size_t size = 150;
+  db::BulkAppender appender(file, batchPages);
+  for (size_t i = 0; i < size; i++) {
+    appender.nextPage()[0] = static_cast<char>(i);
+  }
+  EXPECT_EQ(appender.getNumAppended(), size);
+  EXPECT_EQ(appender.finish(), 0);
+
+  EXPECT_EQ(file.getNumPages(), size);
+  EXPECT_TRUE(file.getReads().empty());
+  const auto &writes = file.getWrites();
+  ASSERT_EQ(writes.size(), size);
+  for (size_t i = 0; i < size; i++) {
+    EXPECT_EQ(writes[i], i);
+    EXPECT_EQ(file.firstBytes[i], static_cast<char>(i));
+  }
+  ASSERT_EQ(file.requests.size(), (size + batchPages - 1) / batchPages);
+  EXPECT_EQ(file.requests.front(), batchPages);
+  EXPECT_EQ(file.requests.back(), size % batchPages);
+  EXPECT_FALSE(bufferPool.searchFile(name));
+}
+
+TEST(BulkAppenderTest, appendToExistingFile) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  const db::DbFile &file = db.get(name);
+  constexpr size_t existing = 3;
+  db::Page page{};
+  for (size_t i = 0; i < existing; i++) {
+    file.writePage(page, i);
+  }
+  // a stale copy of a page past the end of the file must not survive the load
+  bufferPool.getPage({name, existing});
+  bufferPool.getPage({name, 0});
+  {
+    db::BulkAppender appender(file, 2);
+    for (size_t i = 0; i < 5; i++) {
+      appender.nextPage();
+    }
+  }
+  EXPECT_EQ(file.getNumPages(), existing + 5);
+  EXPECT_FALSE(bufferPool.contains({name, existing}));
+  EXPECT_TRUE(bufferPool.contains({name, 0}));
+  const auto &writes = file.getWrites();
+  ASSERT_EQ(writes.size(), existing + 5);
+  for (size_t i = 0; i < writes.size(); i++) {
+    EXPECT_EQ(writes[i], i);
+  }
+}
+
+TEST(BulkAppenderTest, finished) {
+  db::Database &db = db::getDatabase();
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  EXPECT_ANY_THROW(db::BulkAppender(db.get(name), 0));
+  db::BulkAppender appender(db.get(name));
+  EXPECT_EQ(appender.finish(), 0);
+  EXPECT_ANY_THROW(appender.nextPage());
+  EXPECT_TRUE(db.get(name).getWrites().empty());
+}
@@ -0,0 +1,275 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/Scrubber.hpp>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sys/stat.h>
+
+static std::string filePath(const std::string &name) {
+  std::string path = (std::filesystem::temp_directory_path() / name).string();
+  std::filesystem::remove(path);
+  return path;
+}
+
+static db::Page pageOf(char c) {
+  db::Page page;
+  page.fill(c);
+  return page;
+}
+
+static std::vector<char> readSlot(const std::string &path, size_t id) {
+  std::vector<char> slot(db::sealedSize(db::DEFAULT_PAGE_SIZE));
+  std::ifstream in(path, std::ios::binary);
+  in.seekg(static_cast<std::streamoff>(id * slot.size()));
+  in.read(slot.data(), static_cast<std::streamsize>(slot.size()));
+  return slot;
+}
+
+static void writeBytes(const std::string &path, size_t offset, std::span<const char> bytes) {
+  std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+  out.seekp(static_cast<std::streamoff>(offset));
+  out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+TEST(ChecksumTest, crc32c) {
+  std::string check = "123456789";
+  EXPECT_EQ(db::crc32c(check), 0xE3069283U);
+  EXPECT_EQ(db::crc32c({}), 0U);
+  // checksumming in parts gives the same result, whatever the alignment of the parts
+  std::string text(1000, 'x');
+  for (size_t i = 0; i < text.size(); i++) {
+    text[i] = static_cast<char>(i * 31);
+  }
+  uint32_t whole = db::crc32c(text);
+  for (size_t split : {1, 7, 8, 500, 999}) {
+    std::span<const char> bytes{text};
+    EXPECT_EQ(db::crc32c(bytes.subspan(split), db::crc32c(bytes.first(split))), whole);
+  }
+}
+
+TEST(ChecksumTest, verifyPage) {
+  db::Page page = pageOf('a');
+  std::vector<char> slot(db::sealedSize(page.size()));
+  EXPECT_EQ(db::verifyPage(slot), db::PageStatus::Empty);
+  EXPECT_THROW(db::sealPage(page, 0, slot), std::invalid_argument);
+
+  db::sealPage(page, 42, slot);
+  EXPECT_EQ(db::verifyPage(slot), db::PageStatus::Valid);
+  EXPECT_TRUE(std::equal(page.begin(), page.end(), slot.begin() + db::CHECKSUM_HEADER_SIZE));
+
+  // a single flipped bit anywhere in the slot is caught
+  for (size_t offset : {size_t{0}, db::CHECKSUM_HEADER_SIZE + 100, slot.size() - 1}) {
+    slot[offset] ^= 4;
+    EXPECT_NE(db::verifyPage(slot), db::PageStatus::Valid);
+    slot[offset] ^= 4;
+  }
+
+  // the second half of the slot comes from an older write
+  std::vector<char> older(slot.size());
+  db::sealPage(pageOf('b'), 41, older);
+  std::copy(older.begin() + slot.size() / 2, older.end(), slot.begin() + slot.size() / 2);
+  EXPECT_EQ(db::verifyPage(slot), db::PageStatus::Torn);
+}
+
+TEST(ChecksumTest, roundTrip) {
+  std::string path = filePath("checksum_roundtrip");
+  {
+    db::ChecksummedDbFile file("file", path);
+    EXPECT_EQ(file.getNumPages(), 0);
+    std::vector<char> pages(3 * db::DEFAULT_PAGE_SIZE);
+    for (size_t i = 0; i < pages.size(); i++) {
+      pages[i] = static_cast<char>(i / db::DEFAULT_PAGE_SIZE + 1);
+    }
+    file.writePages(pages, 0);
+    file.writePage(pageOf('z'), 5);
+    EXPECT_EQ(file.getNumPages(), 6);
+    EXPECT_EQ(std::filesystem::file_size(path), 6 * db::sealedSize(db::DEFAULT_PAGE_SIZE));
+  }
+
+  db::ChecksummedDbFile file("file", path);
+  EXPECT_EQ(file.getNumPages(), 6);
+  db::Page page;
+  for (size_t i = 0; i < 3; i++) {
+    file.readPage(page, i);
+    EXPECT_EQ(page, pageOf(static_cast<char>(i + 1)));
+    EXPECT_EQ(file.checkPage(i), db::PageStatus::Valid);
+  }
+  // pages that were never written read as zeros
+  file.readPage(page, 3);
+  EXPECT_EQ(page, db::Page{});
+  EXPECT_EQ(file.checkPage(4), db::PageStatus::Empty);
+  std::vector<char> pages(3 * db::DEFAULT_PAGE_SIZE);
+  file.readPages(pages, 3);
+  EXPECT_TRUE(std::equal(pages.end() - db::DEFAULT_PAGE_SIZE, pages.end(), pageOf('z').begin()));
+  std::filesystem::remove(path);
+}
+
+TEST(ChecksumTest, blockAlignment) {
+  static_assert(db::sealedSize(db::DEFAULT_PAGE_SIZE) == 9 * 512);
+  static_assert(db::sealedSize(db::DEFAULT_PAGE_SIZE, 4096) == 2 * db::DEFAULT_PAGE_SIZE);
+  static_assert(db::sealedSize(4096 - 20, 4096) == 4096);
+
+  db::Page page = pageOf('a');
+  std::vector<char> slot(db::sealedSize(page.size()), 'x');
+  db::sealPage(page, 7, slot);
+  EXPECT_EQ(db::verifyPage(slot), db::PageStatus::Valid);
+  // the padding is zeroed and the trailer ends the slot, in its last block
+  auto padding = slot.begin() + db::CHECKSUM_HEADER_SIZE + page.size();
+  EXPECT_TRUE(std::all_of(padding, slot.end() - db::CHECKSUM_TRAILER_SIZE, [](char c) { return c == 0; }));
+  EXPECT_THROW(db::sealPage(page, 7, std::span<char>(slot).first(page.size())), std::invalid_argument);
+
+  std::string path = filePath("checksum_blocks");
+  EXPECT_THROW(db::ChecksummedDbFile("file", path, db::DEFAULT_PAGE_SIZE, 0), std::invalid_argument);
+  {
+    db::ChecksummedDbFile file("file", path, db::DEFAULT_PAGE_SIZE, 4096);
+    EXPECT_EQ(file.getSlotSize(), 2 * db::DEFAULT_PAGE_SIZE);
+    file.writePage(pageOf('b'), 1);
+    EXPECT_EQ(std::filesystem::file_size(path), 2 * file.getSlotSize());
+  }
+  db::ChecksummedDbFile file("file", path, db::DEFAULT_PAGE_SIZE, 4096);
+  EXPECT_EQ(file.getNumPages(), 2);
+  file.readPage(page, 1);
+  EXPECT_EQ(page, pageOf('b'));
+  std::filesystem::remove(path);
+}
+
+TEST(ChecksumTest, lsnFromDisk) {
+  std::string path = filePath("checksum_lsn");
+  // written under a clock that was far ahead of the current one
+  constexpr uint64_t future = UINT64_MAX / 2;
+  std::vector<char> slot(db::sealedSize(db::DEFAULT_PAGE_SIZE));
+  db::sealPage(pageOf('f'), future, slot);
+  std::ofstream(path, std::ios::binary).write(slot.data(), static_cast<std::streamsize>(slot.size()));
+
+  db::ChecksummedDbFile file("file", path);
+  file.writePage(pageOf('n'), 1);
+  EXPECT_EQ(db::slotLsn(readSlot(path, 0)), future);
+  EXPECT_GT(db::slotLsn(readSlot(path, 1)), future);
+  std::filesystem::remove(path);
+}
+
+TEST(ChecksumTest, detectCorruption) {
+  std::string path = filePath("checksum_corrupt");
+  db::ChecksummedDbFile file("file", path);
+  for (size_t i = 0; i < 4; i++) {
+    file.writePage(pageOf('a'), i);
+  }
+  std::vector<char> oldSlot = readSlot(path, 2);
+  file.writePage(pageOf('b'), 2);
+
+  // a flipped byte in the middle of page 1
+  char flipped = 'A';
+  writeBytes(path, db::sealedSize(db::DEFAULT_PAGE_SIZE) + 2000, {&flipped, 1});
+  // only the first 4 KiB of the rewrite of page 2 reached the disk
+  size_t slot = db::sealedSize(db::DEFAULT_PAGE_SIZE);
+  writeBytes(path, 2 * slot + db::DEFAULT_PAGE_SIZE, std::span<const char>(oldSlot).subspan(db::DEFAULT_PAGE_SIZE));
+
+  db::Page page;
+  EXPECT_NO_THROW(file.readPage(page, 0));
+  EXPECT_THROW(file.readPage(page, 1), std::runtime_error);
+  EXPECT_THROW(file.readPage(page, 2), std::runtime_error);
+  EXPECT_EQ(file.checkPage(1), db::PageStatus::Corrupt);
+  EXPECT_EQ(file.checkPage(2), db::PageStatus::Torn);
+  std::vector<char> pages(4 * db::DEFAULT_PAGE_SIZE);
+  EXPECT_THROW(file.readPages(pages, 0), std::runtime_error);
+
+  // rewriting a page repairs it
+  file.writePage(pageOf('c'), 2);
+  file.readPage(page, 2);
+  EXPECT_EQ(page, pageOf('c'));
+  std::filesystem::remove(path);
+}
+
+TEST(ChecksumTest, bufferPoolMiss) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  std::string path = filePath("checksum_pool");
+  db.add(std::make_unique<db::ChecksummedDbFile>("file", path));
+  const db::DbFile &file = db.get("file");
+  file.writePage(pageOf('a'), 0);
+  file.writePage(pageOf('b'), 1);
+  char flipped = 'X';
+  writeBytes(path, db::sealedSize(db::DEFAULT_PAGE_SIZE) + 10, {&flipped, 1});
+
+  EXPECT_EQ(bufferPool.getPage({"file", 0}), pageOf('a'));
+  EXPECT_THROW(bufferPool.getPage({"file", 1}), std::runtime_error);
+  EXPECT_FALSE(bufferPool.contains({"file", 1}));
+
+  // the page is sealed again when it is flushed
+  bufferPool.getPage({"file", 0})[0] = 'x';
+  bufferPool.markDirty({"file", 0});
+  bufferPool.flushPage({"file", 0});
+  EXPECT_EQ(dynamic_cast<const db::ChecksummedDbFile &>(file).checkPage(0), db::PageStatus::Valid);
+  db.remove("file");
+  std::filesystem::remove(path);
+}
+
+TEST(ChecksumTest, scrubber) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  std::string pathA = filePath("checksum_scrub_a");
+  std::string pathB = filePath("checksum_scrub_b");
+  db.add(std::make_unique<db::ChecksummedDbFile>("a", pathA));
+  db.add(std::make_unique<db::ChecksummedDbFile>("b", pathB));
+  const auto &a = dynamic_cast<const db::ChecksummedDbFile &>(db.get("a"));
+  const auto &b = dynamic_cast<const db::ChecksummedDbFile &>(db.get("b"));
+  for (size_t i = 0; i < 10; i++) {
+    a.writePage(pageOf('a'), i);
+    b.writePage(pageOf('b'), i);
+  }
+  bufferPool.getPage({"a", 0});
+  std::vector<db::PageId> resident = bufferPool.getResidentPages();
+  char flipped = 'X';
+  writeBytes(pathB, 7 * db::sealedSize(db::DEFAULT_PAGE_SIZE) + 99, {&flipped, 1});
+
+  {
+    db::Scrubber scrubber({&a, &b}, std::chrono::microseconds(0), std::chrono::milliseconds(0));
+    scrubber.awaitPasses(2);
+    std::vector<db::BadPage> expected{{"b", 7, db::PageStatus::Corrupt}};
+    EXPECT_EQ(scrubber.getBadPages(), expected);
+    db::ScrubStats stats = scrubber.getStats();
+    EXPECT_GE(stats.pages, 40);
+    EXPECT_GE(stats.corrupt, 2);
+    EXPECT_EQ(stats.torn, 0);
+  }
+  // the scrubber reads around the bufferpool
+  EXPECT_EQ(bufferPool.getResidentPages(), resident);
+  // checksummed files do not log their I/O
+  EXPECT_TRUE(a.getReads().empty());
+  EXPECT_TRUE(a.getWrites().empty());
+  EXPECT_EQ(a.getNumPages(), 10);
+  db.remove("a");
+  db.remove("b");
+  std::filesystem::remove(pathA);
+  std::filesystem::remove(pathB);
+}
+
+/**
+ * A checksummed file on a FIFO, whose reads fail, that claims to have pages.
+ */
+class UnreadableFile : public db::ChecksummedDbFile {
+public:
+  using ChecksummedDbFile::ChecksummedDbFile;
+
+  size_t getNumPages() const override { return 2; }
+};
+
+TEST(ChecksumTest, scrubberUnreadable) {
+  std::string path = filePath("checksum_fifo");
+  ASSERT_EQ(mkfifo(path.c_str(), 0644), 0);
+  {
+    UnreadableFile file("fifo", path);
+    db::Scrubber scrubber({&file}, std::chrono::microseconds(0), std::chrono::milliseconds(0));
+    scrubber.awaitPasses(1);
+    // read errors are not checksum mismatches
+    EXPECT_TRUE(scrubber.getBadPages().empty());
+    std::vector<db::PageId> expected{{"fifo", 0}, {"fifo", 1}};
+    EXPECT_EQ(scrubber.getUnreadablePages(), expected);
+    db::ScrubStats stats = scrubber.getStats();
+    EXPECT_EQ(stats.corrupt, 0);
+    EXPECT_GE(stats.unreadable, 2);
+  }
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/PageCompression.hpp>
+#include <db/PageGuard.hpp>
+#include <random>
+
+TEST(CompressedTierTest, roundTrip) {
+  std::mt19937 rng(42);
+  db::Page zeros{};
+  db::Page text{};
+  db::Page noise{};
+  for (size_t i = 0; i < db::DEFAULT_PAGE_SIZE; i++) {
+    text[i] = "tuple,"[i % 6] + static_cast<char>(i / 512);
+    noise[i] = static_cast<char>(rng());
+  }
+  for (const db::Page &page : {zeros, text, noise}) {
+    std::vector<char> compressed = db::compressPage(page);
+    db::Page restored{};
+    db::decompressPage(compressed, restored);
+    EXPECT_EQ(restored, page);
+  }
+  EXPECT_LT(db::compressPage(zeros).size(), db::DEFAULT_PAGE_SIZE / 16);
+  EXPECT_LT(db::compressPage(text).size(), db::DEFAULT_PAGE_SIZE / 4);
+
+  std::vector<char> compressed = db::compressPage(text);
+  db::Page restored{};
+  EXPECT_ANY_THROW(db::decompressPage(std::span(compressed).first(compressed.size() - 1), restored));
+  compressed[compressed.size() - 1] = 0x7F;
+  EXPECT_ANY_THROW(db::decompressPage(std::span(compressed).first(1), restored));
+}
+
+TEST(CompressedTierTest, disabled) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  for (size_t i = 0; i <= db::DEFAULT_NUM_PAGES; i++) {
+    bufferPool.getPage({name, i});
+  }
+  bufferPool.getPage({name, db::DEFAULT_NUM_PAGES});
+  bufferPool.getPage({name, 0});
+  db::BufferPoolStats stats = bufferPool.getStats();
+  EXPECT_EQ(stats.primary.hits, 1);
+  EXPECT_EQ(stats.primary.misses, db::DEFAULT_NUM_PAGES + 2);
+  EXPECT_EQ(stats.secondary.hits + stats.secondary.misses, 0);
+  EXPECT_EQ(db.get(name).getReads().size(), db::DEFAULT_NUM_PAGES + 2);
+}
+
+TEST(CompressedTierTest, spillAndRestore) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  bufferPool.enableSecondTier(db::DEFAULT_NUM_PAGES * db::DEFAULT_PAGE_SIZE);
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  constexpr size_t size = 10;
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+    db::WritePageGuard guard = bufferPool.fetchWrite({name, i});
+    std::fill(guard.getData().begin(), guard.getData().end(), static_cast<char>(i));
+  }
+  // evicts pages [0, size), which are flushed and then compressed into the second tier
+  for (size_t i = 0; i < size; i++) {
+    bufferPool.getPage({name, db::DEFAULT_NUM_PAGES + i});
+  }
+  EXPECT_GT(bufferPool.getStats().secondarySize, 0);
+  const auto &reads = db.get(name).getReads();
+  size_t numReads = reads.size();
+  for (size_t i = 0; i < size; i++) {
+    db::ReadPageGuard guard = bufferPool.fetchRead({name, i});
+    EXPECT_EQ(guard.getData()[0], static_cast<char>(i));
+    EXPECT_EQ(guard.getData()[db::DEFAULT_PAGE_SIZE - 1], static_cast<char>(i));
+  }
+  EXPECT_EQ(reads.size(), numReads);
+  EXPECT_EQ(db.get(name).getWrites().size(), 2 * size);
+  db::BufferPoolStats stats = bufferPool.getStats();
+  EXPECT_EQ(stats.secondary.hits, size);
+  EXPECT_EQ(stats.secondary.misses, db::DEFAULT_NUM_PAGES + size);
+}
+
+TEST(CompressedTierTest, budget) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  constexpr size_t capacity = 256;
+  bufferPool.enableSecondTier(capacity);
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  for (size_t i = 0; i < 3 * db::DEFAULT_NUM_PAGES; i++) {
+    bufferPool.getPage({name, i});
+    EXPECT_LE(bufferPool.getStats().secondarySize, capacity);
+  }
+  // only the most recently evicted pages are still in the second tier
+  size_t numReads = db.get(name).getReads().size();
+  bufferPool.getPage({name, 0});
+  EXPECT_EQ(db.get(name).getReads().size(), numReads + 1);
+  bufferPool.getPage({name, 2 * db::DEFAULT_NUM_PAGES - 1});
+  EXPECT_EQ(db.get(name).getReads().size(), numReads + 1);
+}
+
+TEST(CompressedTierTest, removeFile) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  bufferPool.enableSecondTier(db::DEFAULT_NUM_PAGES * db::DEFAULT_PAGE_SIZE);
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  for (size_t i = 0; i <= db::DEFAULT_NUM_PAGES; i++) {
+    bufferPool.getPage({name, i});
+  }
+  db.remove(name);
+  db.add(std::make_unique<db::DbFile>(name));
+  bufferPool.getPage({name, 0});
+  EXPECT_EQ(db.get(name).getReads().size(), 1);
+  EXPECT_EQ(bufferPool.getStats().secondarySize, 0);
+}
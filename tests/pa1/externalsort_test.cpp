@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/ExternalSort.hpp>
+#include <db/IoScheduler.hpp>
+#include <db/StaticTupleDesc.hpp>
+#include <db/TempDbFile.hpp>
+#include <random>
+
+using Schema = db::StaticTupleDesc<int, double, std::string>;
+
+static std::vector<db::Tuple> readTuples(const db::DbFile &file) {
+  db::TupleDesc td = Schema::runtime();
+  std::vector<db::Tuple> tuples;
+  db::Page page{};
+  for (size_t i = 0; i < file.getNumPages(); i++) {
+    file.readPage(page, i);
+    td.scanPage(page, [&](const db::Tuple &tuple) { tuples.push_back(tuple); });
+  }
+  return tuples;
+}
+
+static void sortAndCheck(size_t numTuples, size_t column, size_t grant, size_t threads, size_t expectedPasses) {
+  db::Database &db = db::getDatabase();
+  db.add(std::make_unique<db::TempDbFile>("input"));
+  db.add(std::make_unique<db::TempDbFile>("output"));
+  const db::DbFile &input = db.get("input");
+  std::mt19937 rng(7);
+  std::uniform_int_distribution<int> keys(-100000, 100000);
+  db::Page page{};
+  for (size_t i = 0; i < numTuples; i++) {
+    int key = keys(rng);
+    if (!Schema::appendTuple(page, key, key / 3.0, "key" + std::to_string(key))) {
+      input.writePage(page, input.getNumPages());
+      page = {};
+      Schema::appendTuple(page, key, key / 3.0, "key" + std::to_string(key));
+    }
+  }
+  input.writePage(page, input.getNumPages());
+
+  db::IoScheduler &scheduler = db.getIoScheduler();
+  size_t prefetches = scheduler.getStats(db::IoClass::Prefetch).requests;
+  db::ExternalSort sort(Schema::runtime(), column, grant, threads);
+  db::SortStats stats = sort.sort("input", "output");
+  EXPECT_GT(stats.runs, 1);
+  EXPECT_EQ(stats.mergePasses, expectedPasses);
+  // every pass reads all of its runs ahead, and they hold at least as many pages as the output
+  EXPECT_GE(scheduler.getStats(db::IoClass::Prefetch).requests - prefetches,
+            expectedPasses * db.get("output").getNumPages());
+
+  std::vector<db::Tuple> expected = readTuples(input);
+  std::vector<db::Tuple> sorted = readTuples(db.get("output"));
+  ASSERT_EQ(sorted.size(), numTuples);
+  auto less = [column](const db::Tuple &a, const db::Tuple &b) { return a.getField(column) < b.getField(column); };
+  EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end(), less));
+  std::sort(expected.begin(), expected.end(), less);
+  for (size_t i = 0; i < numTuples; i++) {
+    EXPECT_EQ(sorted[i].getField(column), expected[i].getField(column));
+  }
+  size_t perPage = Schema::pageCapacity(db::DEFAULT_PAGE_SIZE);
+  EXPECT_EQ(db.get("output").getNumPages(), (numTuples + perPage - 1) / perPage);
+}
+
+TEST(ExternalSortTest, intKeys) {
+  // 4 threads of 128 KiB hold 5 pages each, so about 40 runs are merged 8 at a time
+  sortAndCheck(10000, 0, 128 << 10, 4, 2);
+}
+
+TEST(ExternalSortTest, doubleKeys) { sortAndCheck(3000, 1, 128 << 10, 2, 1); }
+
+TEST(ExternalSortTest, charKeys) { sortAndCheck(3000, 2, 96 << 10, 3, 2); }
+
+TEST(ExternalSortTest, invalid) {
+  db::Database &db = db::getDatabase();
+  db.add(std::make_unique<db::TempDbFile>("input"));
+  db.add(std::make_unique<db::TempDbFile>("output"));
+  EXPECT_THROW(db::ExternalSort(Schema::runtime(), 3), std::invalid_argument);
+  EXPECT_THROW(db::ExternalSort(Schema::runtime(), 0, db::DEFAULT_SORT_GRANT, 0), std::invalid_argument);
+  db::ExternalSort small(Schema::runtime(), 0, 16 * db::DEFAULT_PAGE_SIZE);
+  EXPECT_THROW(small.sort("input", "output"), std::invalid_argument);
+
+  db::ExternalSort empty(Schema::runtime(), 0);
+  db::SortStats stats = empty.sort("input", "output");
+  EXPECT_EQ(stats.runs, 0);
+  EXPECT_EQ(stats.mergePasses, 0);
+  EXPECT_EQ(db.get("output").getNumPages(), 0);
+}
+
+TEST(TempDbFileTest, readWrite) {
+  db::TempDbFile file("temp");
+  db::Page page{};
+  page.fill('x');
+  file.writePage(page, 2);
+  EXPECT_EQ(file.getNumPages(), 3);
+  db::Page read{};
+  read.fill('y');
+  file.readPage(read, 0);
+  EXPECT_EQ(read, db::Page{});
+  file.readPage(read, 2);
+  EXPECT_EQ(read, page);
+  file.readPage(read, 5);
+  EXPECT_EQ(read, db::Page{});
+}
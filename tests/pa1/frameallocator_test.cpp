@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+
+#include <db/BufferPool.hpp>
+#include <db/FrameAllocator.hpp>
+
+TEST(FrameAllocatorTest, smallBudget) {
+  db::FrameAllocator frames(db::DEFAULT_NUM_PAGES * db::DEFAULT_PAGE_SIZE);
+  const db::MemoryLayout &layout = frames.getLayout();
+  EXPECT_EQ(layout.capacity, db::DEFAULT_NUM_PAGES * db::DEFAULT_PAGE_SIZE);
+  EXPECT_EQ(layout.backing, db::PageBacking::Regular);
+  EXPECT_GE(layout.numaNodes, 1);
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+    char *frame = frames.allocate(db::DEFAULT_PAGE_SIZE);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(frame) % db::DEFAULT_PAGE_SIZE, 0);
+  }
+  EXPECT_EQ(frames.allocate(db::DEFAULT_PAGE_SIZE), nullptr);
+}
+
+TEST(FrameAllocatorTest, largeBudget) {
+  constexpr size_t capacity = size_t{8} << 20;
+  db::FrameAllocator frames(capacity, db::NumaPolicy::Partition);
+  const db::MemoryLayout &layout = frames.getLayout();
+  EXPECT_EQ(layout.capacity, capacity);
+  EXPECT_GE(layout.reserved, capacity);
+  EXPECT_NE(layout.backing, db::PageBacking::Huge1G);
+  if (layout.numaNodes == 1) {
+    EXPECT_EQ(layout.numaPolicy, db::NumaPolicy::Local);
+  }
+  for (size_t i = 0; i < capacity / db::MAX_PAGE_SIZE; i++) {
+    char *frame = frames.allocate(db::MAX_PAGE_SIZE);
+    ASSERT_NE(frame, nullptr);
+    frame[0] = frame[db::MAX_PAGE_SIZE - 1] = 1;
+  }
+  EXPECT_EQ(frames.allocate(db::DEFAULT_PAGE_SIZE), nullptr);
+}
+
+TEST(FrameAllocatorTest, bufferPoolLayout) {
+  db::BufferPool bufferPool(size_t{4} << 20);
+  EXPECT_EQ(bufferPool.getMemoryLayout().capacity, size_t{4} << 20);
+  EXPECT_GE(bufferPool.getMemoryLayout().numaNodes, 1);
+}
@@ -0,0 +1,280 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/IoScheduler.hpp>
+#include <db/TempDbFile.hpp>
+#include <atomic>
+#include <future>
+#include <thread>
+
+using namespace std::chrono_literals;
+
+/**
+ * A file whose writes of page 0 wait until the gate is opened, so later requests queue up behind them.
+ */
+class GatedFile : public db::TempDbFile {
+  std::shared_future<void> gate;
+
+public:
+  mutable std::atomic<size_t> active{0};
+  mutable std::atomic<size_t> maxActive{0};
+
+  GatedFile(const std::string &name, std::shared_future<void> gate) : TempDbFile(name), gate(std::move(gate)) {}
+
+  void writePages(std::span<const char> pages, size_t id) const override {
+    size_t now = ++active;
+    maxActive = std::max(maxActive.load(), now);
+    if (id == 0) {
+      gate.wait();
+    }
+    TempDbFile::writePages(pages, id);
+    active--;
+  }
+};
+
+/**
+ * A file whose reads fail.
+ */
+class FailingFile : public db::DbFile {
+public:
+  using DbFile::DbFile;
+
+  void readPages(std::span<char>, size_t id) const override {
+    throw std::runtime_error("Could not read page " + std::to_string(id));
+  }
+};
+
+/**
+ * Waits until a write of page 0 of the file is blocked on its gate.
+ */
+static void awaitBlocked(const GatedFile &file) {
+  while (file.active == 0) {
+    std::this_thread::yield();
+  }
+}
+
+static std::array<size_t, db::NUM_IO_CLASSES> depths(size_t foreground, size_t prefetch, size_t background,
+                                                     size_t bulk) {
+  return {foreground, prefetch, background, bulk};
+}
+
+TEST(IoSchedulerTest, mergeAdjacent) {
+  std::promise<void> open;
+  GatedFile file("gated", open.get_future().share());
+  db::IoScheduler scheduler(depths(0, 0, 1, 0));
+
+  std::vector<db::Page> pages(10);
+  for (size_t i = 0; i < pages.size(); i++) {
+    pages[i].fill(static_cast<char>('a' + i));
+  }
+  std::vector<std::future<void>> pending;
+  pending.push_back(scheduler.submitWrite(db::IoClass::BackgroundWrite, file, pages[0], 0));
+  awaitBlocked(file);
+  // queued out of order, they still make up pages 1 to 9
+  for (size_t i : {5, 6, 2, 1, 3, 4, 9, 8, 7}) {
+    pending.push_back(scheduler.submitWrite(db::IoClass::BackgroundWrite, file, pages[i], i));
+  }
+  open.set_value();
+  for (std::future<void> &done : pending) {
+    done.get();
+  }
+
+  db::IoClassStats stats = scheduler.getStats(db::IoClass::BackgroundWrite);
+  EXPECT_EQ(stats.requests, 10);
+  EXPECT_EQ(stats.pages, 10);
+  EXPECT_EQ(stats.dispatches, 2);
+  EXPECT_EQ(file.getNumPages(), 10);
+  db::Page page;
+  for (size_t i = 0; i < pages.size(); i++) {
+    file.readPage(page, i);
+    EXPECT_EQ(page, pages[i]);
+  }
+}
+
+TEST(IoSchedulerTest, mergeLimit) {
+  std::promise<void> open;
+  GatedFile file("gated", open.get_future().share());
+  db::IoScheduler scheduler(depths(0, 0, 0, 1));
+
+  std::vector<char> pages((2 * db::MAX_IO_MERGE_PAGES + 1) * db::DEFAULT_PAGE_SIZE);
+  std::vector<std::future<void>> pending;
+  for (size_t i = 0; i < 2 * db::MAX_IO_MERGE_PAGES + 1; i++) {
+    std::span<const char> page{pages.data() + i * db::DEFAULT_PAGE_SIZE, db::DEFAULT_PAGE_SIZE};
+    pending.push_back(scheduler.submitWrite(db::IoClass::Bulk, file, page, i));
+    if (i == 0) {
+      awaitBlocked(file);
+    }
+  }
+  open.set_value();
+  for (std::future<void> &done : pending) {
+    done.get();
+  }
+  // page 0 alone, then two full merges
+  EXPECT_EQ(scheduler.getStats(db::IoClass::Bulk).dispatches, 3);
+}
+
+TEST(IoSchedulerTest, mergedReads) {
+  db::TempDbFile file("file");
+  std::vector<db::Page> pages(4);
+  for (size_t i = 0; i < pages.size(); i++) {
+    pages[i].fill(static_cast<char>('0' + i));
+    file.writePage(pages[i], i);
+  }
+  db::IoScheduler scheduler;
+  std::vector<db::Page> read(4);
+  std::vector<std::future<void>> pending;
+  for (size_t i = 0; i < read.size(); i++) {
+    pending.push_back(scheduler.submitRead(db::IoClass::Prefetch, file, read[i], i));
+  }
+  for (std::future<void> &done : pending) {
+    done.get();
+  }
+  EXPECT_EQ(read, pages);
+  EXPECT_EQ(scheduler.getStats(db::IoClass::Prefetch).requests, 4);
+}
+
+TEST(IoSchedulerTest, depthLimit) {
+  std::promise<void> open;
+  GatedFile file("gated", open.get_future().share());
+  db::IoScheduler scheduler(depths(1, 0, 0, 1));
+
+  db::Page page{};
+  file.writePage(page, 1);
+  std::future<void> blocked = scheduler.submitWrite(db::IoClass::Bulk, file, page, 0);
+  awaitBlocked(file);
+  std::future<void> queued = scheduler.submitWrite(db::IoClass::Bulk, file, page, 5);
+  // a bulk request is in flight, so the second one waits even though a worker is idle
+  EXPECT_EQ(queued.wait_for(50ms), std::future_status::timeout);
+
+  // a foreground request does not wait behind the bulk ones
+  db::Page read;
+  scheduler.submitRead(db::IoClass::ForegroundRead, file, read, 1).get();
+  EXPECT_EQ(blocked.wait_for(0ms), std::future_status::timeout);
+
+  open.set_value();
+  blocked.get();
+  queued.get();
+  EXPECT_EQ(file.maxActive, 1);
+}
+
+TEST(IoSchedulerTest, writesOfPageInOrder) {
+  std::promise<void> open;
+  GatedFile file("gated", open.get_future().share());
+  db::IoScheduler scheduler(depths(0, 0, 2, 1));
+
+  db::Page older;
+  older.fill('o');
+  db::Page newer;
+  newer.fill('n');
+  std::future<void> first = scheduler.submitWrite(db::IoClass::BackgroundWrite, file, older, 0);
+  awaitBlocked(file);
+  std::future<void> second = scheduler.submitWrite(db::IoClass::BackgroundWrite, file, newer, 0);
+  db::Page bulk;
+  bulk.fill('b');
+  std::future<void> third = scheduler.submitWrite(db::IoClass::Bulk, file, bulk, 0);
+  // a worker is idle, but the page is still being written
+  EXPECT_EQ(second.wait_for(50ms), std::future_status::timeout);
+
+  open.set_value();
+  first.get();
+  second.get();
+  third.get();
+  EXPECT_EQ(file.maxActive, 1);
+  db::Page page;
+  file.readPage(page, 0);
+  EXPECT_EQ(page, bulk);
+}
+
+TEST(IoSchedulerTest, errors) {
+  EXPECT_THROW(db::IoScheduler(depths(0, 0, 0, 0)), std::invalid_argument);
+
+  db::IoScheduler scheduler(depths(1, 0, 0, 0));
+  db::Page page{};
+  db::DbFile file("file");
+  EXPECT_THROW(scheduler.submitWrite(db::IoClass::Bulk, file, page, 0), std::invalid_argument);
+  // synchronous requests do not need a queue
+  EXPECT_NO_THROW(scheduler.write(db::IoClass::Bulk, file, page, 0));
+
+  // a failed request hands its error to the future
+  FailingFile failing("failing");
+  std::future<void> done = scheduler.submitRead(db::IoClass::ForegroundRead, failing, page, 3);
+  EXPECT_THROW(done.get(), std::runtime_error);
+  EXPECT_EQ(scheduler.getStats(db::IoClass::ForegroundRead).requests, 1);
+}
+
+TEST(IoSchedulerTest, stats) {
+  db::IoScheduler scheduler;
+  db::DbFile file("file");
+  db::Page page{};
+  for (size_t i = 0; i < 10; i++) {
+    scheduler.read(db::IoClass::ForegroundRead, file, page, i);
+  }
+  db::IoClassStats stats = scheduler.getStats(db::IoClass::ForegroundRead);
+  EXPECT_EQ(stats.requests, 10);
+  EXPECT_EQ(stats.dispatches, 10);
+  EXPECT_EQ(stats.pages, 10);
+  EXPECT_LE(stats.maxLatency, stats.totalLatency);
+  size_t total = 0;
+  for (size_t count : stats.histogram) {
+    total += count;
+  }
+  EXPECT_EQ(total, 10);
+  EXPECT_LE(stats.percentile(0.5), stats.percentile(0.99));
+  EXPECT_GE(stats.percentile(1.0), std::chrono::duration_cast<std::chrono::microseconds>(stats.maxLatency));
+  EXPECT_EQ(scheduler.getStats(db::IoClass::Bulk).requests, 0);
+  EXPECT_EQ(scheduler.getStats(db::IoClass::Bulk).percentile(0.99), 0us);
+}
+
+TEST(IoSchedulerTest, bufferPoolClasses) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  db::IoScheduler &scheduler = db.getIoScheduler();
+  db.add(std::make_unique<db::DbFile>("file"));
+
+  size_t reads = scheduler.getStats(db::IoClass::ForegroundRead).requests;
+  for (size_t i = 0; i < 5; i++) {
+    bufferPool.getPage({"file", i});
+  }
+  bufferPool.getPage({"file", 0});
+  EXPECT_EQ(scheduler.getStats(db::IoClass::ForegroundRead).requests, reads + 5);
+
+  size_t writes = scheduler.getStats(db::IoClass::BackgroundWrite).pages;
+  for (size_t i = 0; i < 5; i++) {
+    bufferPool.markDirty({"file", i});
+  }
+  bufferPool.flushFile("file");
+  db::IoClassStats stats = scheduler.getStats(db::IoClass::BackgroundWrite);
+  EXPECT_EQ(stats.pages, writes + 5);
+  EXPECT_LE(stats.dispatches, stats.requests);
+  for (size_t i = 0; i < 5; i++) {
+    EXPECT_FALSE(bufferPool.isDirty({"file", i}));
+  }
+}
+
+TEST(IoSchedulerTest, flushDoesNotBlockMisses) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  std::promise<void> open;
+  auto gated = std::make_unique<GatedFile>("gated", open.get_future().share());
+  const GatedFile &file = *gated;
+  db.add(std::move(gated));
+  db.add(std::make_unique<db::DbFile>("other"));
+
+  bufferPool.getPage({"gated", 0});
+  bufferPool.markDirty({"gated", 0});
+  std::future<void> flushed = std::async(std::launch::async, [&] { bufferPool.flushFile("gated"); });
+  awaitBlocked(file);
+  // misses on another thread go on while the flush waits for its write, evicting around the pinned page
+  std::future<void> misses = std::async(std::launch::async, [&] {
+    for (size_t i = 0; i < 2 * db::DEFAULT_NUM_PAGES; i++) {
+      bufferPool.getPage({"other", i});
+    }
+  });
+  EXPECT_EQ(misses.wait_for(10s), std::future_status::ready);
+  EXPECT_EQ(flushed.wait_for(0s), std::future_status::timeout);
+  open.set_value();
+  misses.get();
+  flushed.get();
+  EXPECT_TRUE(bufferPool.contains({"gated", 0}));
+  EXPECT_FALSE(bufferPool.isDirty({"gated", 0}));
+}
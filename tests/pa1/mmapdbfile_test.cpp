@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/MmapDbFile.hpp>
+#include <db/PageGuard.hpp>
+#include <filesystem>
+#include <fstream>
+
+static std::string createFile(const std::string &name, size_t numPages) {
+  std::string path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  db::Page page{};
+  for (size_t i = 0; i < numPages; i++) {
+    page.fill(static_cast<char>(i + 1));
+    out.write(page.data(), page.size());
+  }
+  return path;
+}
+
+TEST(MmapDbFileTest, getPage) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  constexpr size_t size = 4;
+  std::string name = createFile("mmapdbfile_getPage.db", size);
+  db.add(std::make_unique<db::MmapDbFile>(name));
+  const db::DbFile &file = db.get(name);
+  for (size_t i = 0; i < size; i++) {
+    db::PageId pid{name, i};
+    std::span<const char> page = bufferPool.viewPage(pid);
+    EXPECT_EQ(page.data(), file.mappedPage(i).data());
+    EXPECT_EQ(page.data(), bufferPool.viewPage(pid).data());
+    EXPECT_EQ(page[0], static_cast<char>(i + 1));
+    EXPECT_EQ(page[db::DEFAULT_PAGE_SIZE - 1], static_cast<char>(i + 1));
+    EXPECT_FALSE(bufferPool.contains(pid));
+  }
+  EXPECT_ANY_THROW(bufferPool.viewPage({name, size}));
+  EXPECT_ANY_THROW(bufferPool.getPage({name, size}));
+  std::filesystem::remove(name);
+}
+
+TEST(MmapDbFileTest, notEvictable) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  constexpr size_t size = 8;
+  std::string name = createFile("mmapdbfile_notEvictable.db", size);
+  db.add(std::make_unique<db::MmapDbFile>(name, db::MmapDbFile::Access::Sequential));
+  std::string other{"file"};
+  db.add(std::make_unique<db::DbFile>(other));
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+    bufferPool.getPage({other, i});
+  }
+  for (size_t i = 0; i < size; i++) {
+    bufferPool.viewPage({name, i});
+    bufferPool.fetchRead({name, i});
+  }
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+    EXPECT_TRUE(bufferPool.contains({other, i}));
+  }
+  EXPECT_EQ(db.get(other).getReads().size(), db::DEFAULT_NUM_PAGES);
+  std::filesystem::remove(name);
+}
+
+TEST(MmapDbFileTest, readOnly) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name = createFile("mmapdbfile_readOnly.db", 2);
+  db.add(std::make_unique<db::MmapDbFile>(name));
+  db::PageId pid{name, 1};
+  EXPECT_ANY_THROW(bufferPool.fetchWrite(pid));
+
+  // the mutable accessors work on a copy of the page in a frame
+  db::Page &copy = bufferPool.getPage(pid);
+  EXPECT_NE(copy.data(), db.get(name).mappedPage(1).data());
+  EXPECT_TRUE(bufferPool.contains(pid));
+  EXPECT_EQ(copy[0], 2);
+  copy[0] = 'x';
+  EXPECT_EQ(db.get(name).mappedPage(1)[0], 2);
+  EXPECT_ANY_THROW(bufferPool.markDirty(pid));
+  // once the page has a frame, the read-only accessors return the frame
+  EXPECT_EQ(bufferPool.viewPage(pid).data(), copy.data());
+
+  const db::DbFile &file = db.get(name);
+  db::Page page{};
+  file.readPage(page, 1);
+  EXPECT_EQ(page[0], 2);
+  EXPECT_ANY_THROW(file.writePage(page, 1));
+  std::filesystem::remove(name);
+}
+
+TEST(MmapDbFileTest, missingFile) { EXPECT_ANY_THROW(db::MmapDbFile("/nonexistent/mmapdbfile.db")); }
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <db/Database.hpp>
+#include <db/DbFile.hpp>
+#include <db/PageGuard.hpp>
+#include <db/TempDbFile.hpp>
+#include <future>
+#include <limits>
+#include <thread>
+
+TEST(PageGuardTest, readGuardPins) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  db::PageId pid{name, 0};
+  {
+    db::ReadPageGuard guard = bufferPool.fetchRead(pid);
+    const db::Page *page = &guard.getPage();
+    for (size_t i = 1; i <= 2 * db::DEFAULT_NUM_PAGES; i++) {
+      bufferPool.getPage({name, i});
+    }
+    EXPECT_TRUE(bufferPool.contains(pid));
+    EXPECT_EQ(page, &bufferPool.getPage(pid));
+    EXPECT_ANY_THROW(bufferPool.discardPage(pid));
+  }
+  bufferPool.discardPage(pid);
+  EXPECT_FALSE(bufferPool.contains(pid));
+}
+
+TEST(PageGuardTest, writeGuardMarksDirty) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  db::PageId pid{name, 0};
+  db::WritePageGuard guard = bufferPool.fetchWrite(pid);
+  guard.getData()[0] = 'x';
+  EXPECT_FALSE(bufferPool.isDirty(pid));
+  guard.release();
+  EXPECT_TRUE(bufferPool.isDirty(pid));
+  EXPECT_TRUE(guard.getData().empty());
+  EXPECT_EQ(bufferPool.getPage(pid)[0], 'x');
+}
+
+TEST(PageGuardTest, move) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  db::PageId pid{name, 0};
+  db::ReadPageGuard first = bufferPool.fetchRead(pid);
+  db::ReadPageGuard second = std::move(first);
+  EXPECT_TRUE(first.getData().empty());
+  EXPECT_EQ(second.getData().size(), db::DEFAULT_PAGE_SIZE);
+  first = bufferPool.fetchRead({name, 1});
+  second = std::move(first);
+  EXPECT_NO_THROW(bufferPool.discardPage(pid));
+  EXPECT_ANY_THROW(bufferPool.discardPage({name, 1}));
+}
+
+TEST(PageGuardTest, allPinned) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  std::vector<db::ReadPageGuard> guards;
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+    guards.push_back(bufferPool.fetchRead({name, i}));
+  }
+  EXPECT_ANY_THROW(bufferPool.getPage({name, db::DEFAULT_NUM_PAGES}));
+  guards.pop_back();
+  EXPECT_NO_THROW(bufferPool.getPage({name, db::DEFAULT_NUM_PAGES}));
+  EXPECT_FALSE(bufferPool.contains({name, db::DEFAULT_NUM_PAGES - 1}));
+}
+
+TEST(PageGuardTest, pinOverflow) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  db::PageId pid{name, 0};
+  std::vector<db::ReadPageGuard> guards;
+  for (size_t i = 0; i < std::numeric_limits<uint16_t>::max(); i++) {
+    guards.push_back(bufferPool.fetchRead(pid));
+  }
+  EXPECT_THROW(bufferPool.fetchRead(pid), std::overflow_error);
+  EXPECT_THROW(bufferPool.fetchWrite(pid), std::overflow_error);
+  guards.pop_back();
+  EXPECT_NO_THROW(bufferPool.fetchRead(pid));
+  guards.clear();
+  EXPECT_NO_THROW(bufferPool.discardPage(pid));
+}
+
+TEST(PageGuardTest, concurrentWriters) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  constexpr size_t numThreads = 4;
+  constexpr size_t size = 1000;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < numThreads; t++) {
+    threads.emplace_back([&bufferPool, &name, t] {
+      for (size_t i = 0; i < size; i++) {
+        {
+          db::WritePageGuard guard = bufferPool.fetchWrite({name, 0});
+          size_t count;
+          std::memcpy(&count, guard.getData().data(), sizeof(count));
+          count++;
+          std::memcpy(guard.getData().data(), &count, sizeof(count));
+        }
+        // churn the rest of the pool to force evictions around the hot page
+        db::ReadPageGuard guard = bufferPool.fetchRead({name, 1 + (t * size + i) % (2 * db::DEFAULT_NUM_PAGES)});
+      }
+    });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+  db::ReadPageGuard guard = bufferPool.fetchRead({name, 0});
+  size_t count;
+  std::memcpy(&count, guard.getData().data(), sizeof(count));
+  EXPECT_EQ(count, numThreads * size);
+}
+
+TEST(PageGuardTest, flushWaitsForWriter) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::TempDbFile>(name));
+  db::PageId pid{name, 0};
+  bufferPool.getPage(pid);
+  bufferPool.markDirty(pid);
+  db::WritePageGuard guard = bufferPool.fetchWrite(pid);
+  std::span<char> data = guard.getData();
+  std::fill(data.begin(), data.begin() + data.size() / 2, 'x');
+  std::future<void> flushed = std::async(std::launch::async, [&] { bufferPool.flushPage(pid); });
+  EXPECT_EQ(flushed.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+  std::fill(data.begin() + data.size() / 2, data.end(), 'x');
+  guard.release();
+  flushed.get();
+
+  db::Page page;
+  db.get(name).readPage(page, 0);
+  EXPECT_TRUE(std::all_of(page.begin(), page.end(), [](char c) { return c == 'x'; }));
+}
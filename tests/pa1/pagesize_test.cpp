@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/DbFile.hpp>
+
+TEST(PageSizeTest, invalidPageSize) {
+  EXPECT_ANY_THROW(db::DbFile("file", 1024));
+  EXPECT_ANY_THROW(db::DbFile("file", 3 * db::DEFAULT_PAGE_SIZE));
+  EXPECT_ANY_THROW(db::DbFile("file", 2 * db::MAX_PAGE_SIZE));
+  EXPECT_EQ(db::DbFile("file", db::MAX_PAGE_SIZE).getPageSize(), db::MAX_PAGE_SIZE);
+}
+
+TEST(PageSizeTest, getPageSpan) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  constexpr size_t pageSize = 16384;
+  db.add(std::make_unique<db::DbFile>(name, pageSize));
+  std::span<char> page = bufferPool.getPageSpan({name, 0});
+  EXPECT_EQ(page.size(), pageSize);
+  EXPECT_EQ(page.data(), bufferPool.getPageSpan({name, 0}).data());
+  EXPECT_ANY_THROW(bufferPool.getPage({name, 0}));
+  EXPECT_EQ(db.get(name).getReads().size(), 1);
+}
+
+TEST(PageSizeTest, sharedBudget) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string small{"small"};
+  std::string large{"large"};
+  db.add(std::make_unique<db::DbFile>(small));
+  db.add(std::make_unique<db::DbFile>(large, db::MAX_PAGE_SIZE));
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+    bufferPool.getPage({small, i});
+  }
+  // one large page takes the space of the least recently used small pages
+  constexpr size_t evicted = db::MAX_PAGE_SIZE / db::DEFAULT_PAGE_SIZE;
+  bufferPool.getPageSpan({large, 0});
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+    EXPECT_EQ(bufferPool.contains({small, i}), i >= evicted);
+  }
+  EXPECT_TRUE(bufferPool.contains({large, 0}));
+}
+
+TEST(PageSizeTest, arenaReuse) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name, db::MAX_PAGE_SIZE));
+  constexpr size_t capacity = db::DEFAULT_NUM_PAGES * db::DEFAULT_PAGE_SIZE / db::MAX_PAGE_SIZE;
+  std::array<char *, capacity> pages{};
+  for (size_t i = 0; i < capacity; i++) {
+    pages[i] = bufferPool.getPageSpan({name, i}).data();
+    bufferPool.markDirty({name, i});
+  }
+  char *page = bufferPool.getPageSpan({name, capacity}).data();
+  EXPECT_EQ(page, pages[0]);
+  EXPECT_FALSE(bufferPool.contains({name, 0}));
+
+  const auto &writes = db.get(name).getWrites();
+  EXPECT_EQ(writes.size(), 1);
+  EXPECT_EQ(writes[0], 0);
+}
@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/MmapDbFile.hpp>
+#include <db/PageSummary.hpp>
+#include <db/ScanRing.hpp>
+#include <db/StaticTupleDesc.hpp>
+#include <db/TempDbFile.hpp>
+#include <filesystem>
+#include <fstream>
+
+using Schema = db::StaticTupleDesc<int, double, std::string>;
+
+static db::Page makePage(int first, int step) {
+  db::Page page{};
+  for (int key = first; Schema::appendTuple(page, key, key / 2.0, "k" + std::to_string(key)); key += step) {
+  }
+  return page;
+}
+
+TEST(PageSummaryTest, zoneMaps) {
+  db::DbFile file("file");
+  file.summarize(Schema::runtime(), {0, 1}, {});
+  std::shared_ptr<const db::PageSummary> summary = file.getSummary();
+  ASSERT_NE(summary, nullptr);
+  size_t perPage = Schema::pageCapacity(db::DEFAULT_PAGE_SIZE);
+  for (size_t i = 0; i < 20; i++) {
+    file.writePage(makePage(static_cast<int>(i * perPage), 1), i);
+  }
+  EXPECT_EQ(summary->getNumPages(), 20);
+
+  int low = static_cast<int>(3 * perPage + 5);
+  int high = static_cast<int>(5 * perPage + 1);
+  EXPECT_EQ(summary->candidatePages(0, low, high), std::vector<size_t>({3, 4, 5}));
+  EXPECT_EQ(summary->candidatePages(1, low / 2.0, high / 2.0), std::vector<size_t>({3, 4, 5}));
+  EXPECT_EQ(summary->candidatePages(0, db::field_t(low)), std::vector<size_t>({3}));
+  EXPECT_TRUE(summary->candidatePages(0, -10, -1).empty());
+
+  file.writePage(makePage(100000, 1), 3);
+  EXPECT_EQ(summary->candidatePages(0, low, high), std::vector<size_t>({4, 5}));
+  EXPECT_EQ(summary->candidatePages(0, 100000, 100000), std::vector<size_t>({3}));
+  file.writePage(db::Page{}, 4);
+  EXPECT_EQ(summary->candidatePages(0, low, high), std::vector<size_t>({5}));
+
+  EXPECT_THROW(summary->candidatePages(2, 0, 1), std::invalid_argument);
+  EXPECT_THROW(summary->candidatePages(2, db::field_t(std::string("k1"))), std::invalid_argument);
+  EXPECT_THROW(summary->candidatePages(0, db::field_t(1.0)), std::invalid_argument);
+  EXPECT_THROW(file.summarize(Schema::runtime(), {2}, {}), std::invalid_argument);
+}
+
+TEST(PageSummaryTest, bloomFilters) {
+  db::DbFile file("file");
+  file.summarize(Schema::runtime(), {}, {0, 2});
+  std::shared_ptr<const db::PageSummary> summary = file.getSummary();
+  constexpr size_t numPages = 64;
+  // keys are interleaved across pages, so zone maps could not skip anything
+  for (size_t i = 0; i < numPages; i++) {
+    file.writePage(makePage(static_cast<int>(i), numPages), i);
+  }
+
+  size_t candidates = 0;
+  size_t probes = 0;
+  for (size_t i = 0; i < numPages; i++) {
+    for (int key = static_cast<int>(i); key < 50 * static_cast<int>(numPages); key += 7 * numPages) {
+      std::vector<size_t> pages = summary->candidatePages(0, db::field_t(key));
+      EXPECT_NE(std::find(pages.begin(), pages.end(), i), pages.end());
+      pages = summary->candidatePages(2, db::field_t("k" + std::to_string(key)));
+      EXPECT_NE(std::find(pages.begin(), pages.end(), i), pages.end());
+      candidates += pages.size();
+      probes++;
+    }
+  }
+  // one true match per probe, plus false positives on a small fraction of the other pages
+  EXPECT_LT(candidates, probes * (1 + numPages / 20));
+  EXPECT_LT(summary->candidatePages(0, db::field_t(-1)).size(), numPages / 20);
+}
+
+TEST(PageSummaryTest, skipPages) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  db::DbFile &file = db.get(name);
+  bufferPool.getPage({name, 0});
+  file.summarize(Schema::runtime(), {0}, {0});
+  size_t perPage = Schema::pageCapacity(db::DEFAULT_PAGE_SIZE);
+  for (size_t i = 0; i < 100; i++) {
+    file.writePage(makePage(static_cast<int>(i * perPage), 1), i);
+  }
+
+  int key = static_cast<int>(42 * perPage + 7);
+  std::vector<size_t> pages;
+  {
+    db::ScanRing ring = bufferPool.beginScan();
+    ring.scanMatching(name, 0, db::field_t(key), [&](size_t page, std::span<const char>) { pages.push_back(page); });
+  }
+  EXPECT_EQ(pages, std::vector<size_t>{42});
+  EXPECT_EQ(file.getReads(), std::vector<size_t>({0, 42}));
+  // the ring hands its page to the cold end of the LRU list
+  EXPECT_EQ(bufferPool.getResidentPages().back(), db::PageId({name, 42}));
+}
+
+TEST(PageSummaryTest, dirtyPages) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  std::string name{"file"};
+  db.add(std::make_unique<db::TempDbFile>(name));
+  bufferPool.fetchWrite({name, 0}).getPage() = makePage(7000, 1);
+  // the page only exists in the pool, so it has to be flushed before the summary is built
+  db.get(name).summarize(Schema::runtime(), {0}, {});
+  EXPECT_EQ(db.get(name).getSummary()->candidatePages(0, 7000, 7000), std::vector<size_t>({0}));
+}
+
+TEST(PageSummaryTest, buildFromFile) {
+  std::string path = (std::filesystem::temp_directory_path() / "pagesummary_build.db").string();
+  {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    for (int i = 0; i < 8; i++) {
+      db::Page page = makePage(i * 1000, 1);
+      out.write(page.data(), page.size());
+    }
+  }
+  db::MmapDbFile file(path);
+  file.summarize(Schema::runtime(), {0}, {2});
+  EXPECT_EQ(file.getSummary()->getNumPages(), 8);
+  EXPECT_EQ(file.getSummary()->candidatePages(0, 2500, 3010), std::vector<size_t>({3}));
+  std::vector<size_t> pages = file.getSummary()->candidatePages(2, db::field_t(std::string("k5003")));
+  EXPECT_NE(std::find(pages.begin(), pages.end(), 5), pages.end());
+  EXPECT_LE(pages.size(), 2);
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/DbFile.hpp>
+#include <db/ScanRing.hpp>
+#include <set>
+
+TEST(ScanRingTest, keepsHotSet) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string hot{"hot"};
+  std::string big{"big"};
+  db.add(std::make_unique<db::DbFile>(hot));
+  db.add(std::make_unique<db::DbFile>(big));
+  constexpr size_t hotPages = db::DEFAULT_NUM_PAGES - db::DEFAULT_RING_PAGES;
+  for (size_t i = 0; i < hotPages; i++) {
+    bufferPool.getPage({hot, i});
+  }
+  constexpr size_t size = 4 * db::DEFAULT_NUM_PAGES;
+  {
+    db::ScanRing ring = bufferPool.beginScan();
+    std::set<db::Page *> frames;
+    for (size_t i = 0; i < size; i++) {
+      frames.insert(&ring.getPage({big, i}));
+    }
+    EXPECT_EQ(frames.size(), db::DEFAULT_RING_PAGES);
+  }
+  for (size_t i = 0; i < hotPages; i++) {
+    EXPECT_TRUE(bufferPool.contains({hot, i}));
+  }
+  EXPECT_EQ(db.get(hot).getReads().size(), hotPages);
+  EXPECT_EQ(db.get(big).getReads().size(), size);
+}
+
+TEST(ScanRingTest, residentPages) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  db::Page *page = &bufferPool.getPage({name, 1});
+  db::ScanRing ring = bufferPool.beginScan(2);
+  for (size_t i = 0; i < 4; i++) {
+    db::Page *scanned = &ring.getPage({name, i});
+    if (i == 1) {
+      EXPECT_EQ(scanned, page);
+    }
+  }
+  EXPECT_TRUE(bufferPool.contains({name, 1}));
+  EXPECT_FALSE(bufferPool.contains({name, 0}));
+  EXPECT_EQ(db.get(name).getReads().size(), 4);
+}
+
+TEST(ScanRingTest, promoteAndEnd) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  std::string other{"other"};
+  db.add(std::make_unique<db::DbFile>(name));
+  db.add(std::make_unique<db::DbFile>(other));
+  constexpr size_t ringPages = 4;
+  constexpr size_t size = 3 * ringPages;
+  {
+    db::ScanRing ring = bufferPool.beginScan(ringPages);
+    ring.getPage({name, 0});
+    // a regular request moves the page into the LRU list, out of the ring's reach
+    bufferPool.getPage({name, 0});
+    for (size_t i = 1; i < size; i++) {
+      ring.getPage({name, i});
+      if (i == 1) {
+        bufferPool.markDirty({name, i});
+      }
+    }
+    EXPECT_TRUE(bufferPool.contains({name, 0}));
+    EXPECT_FALSE(bufferPool.contains({name, 1}));
+    const auto &writes = db.get(name).getWrites();
+    ASSERT_EQ(writes.size(), 1);
+    EXPECT_EQ(writes[0], 1);
+  }
+  // the ring's pages stay resident as the least recently used pages
+  for (size_t i = size - ringPages; i < size; i++) {
+    EXPECT_TRUE(bufferPool.contains({name, i}));
+  }
+  size_t resident = ringPages + 1;
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES - resident + 1; i++) {
+    bufferPool.getPage({other, i});
+  }
+  EXPECT_FALSE(bufferPool.contains({name, size - ringPages}));
+  EXPECT_TRUE(bufferPool.contains({name, size - ringPages + 1}));
+  EXPECT_TRUE(bufferPool.contains({name, 0}));
+}
+
+TEST(ScanRingTest, invalidRing) {
+  db::BufferPool &bufferPool = db::getDatabase().getBufferPool();
+  EXPECT_ANY_THROW(bufferPool.beginScan(0));
+  EXPECT_ANY_THROW(bufferPool.beginScan(db::DEFAULT_NUM_PAGES));
+}
+
+TEST(ScanRingTest, guardPinsResidentPage) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  std::string other{"other"};
+  db.add(std::make_unique<db::DbFile>(name));
+  db.add(std::make_unique<db::DbFile>(other));
+  bufferPool.getPage({name, 0});
+  db::ScanRing ring = bufferPool.beginScan();
+  {
+    db::ReadPageGuard guard = ring.fetchRead({name, 0});
+    // the page sits in the LRU list, where any other miss could otherwise recycle it
+    for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+      bufferPool.getPage({other, i});
+    }
+    EXPECT_TRUE(bufferPool.contains({name, 0}));
+  }
+  bufferPool.getPage({other, db::DEFAULT_NUM_PAGES});
+  EXPECT_FALSE(bufferPool.contains({name, 0}));
+}
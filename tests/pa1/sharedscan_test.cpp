@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/DbFile.hpp>
+#include <db/SharedScan.hpp>
+#include <db/TempDbFile.hpp>
+#include <set>
+
+static void createPages(const db::DbFile &file, size_t numPages) {
+  db::Page page{};
+  for (size_t i = 0; i < numPages; i++) {
+    file.writePage(page, i);
+  }
+}
+
+TEST(SharedScanTest, singleScan) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  constexpr size_t size = 2 * db::DEFAULT_NUM_PAGES;
+  createPages(db.get(name), size);
+  db::SharedScan scan = bufferPool.beginSharedScan(name);
+  EXPECT_EQ(scan.getStart(), 0);
+  for (size_t i = 0; i < size; i++) {
+    auto [page, data] = scan.next();
+    EXPECT_EQ(page, i);
+    EXPECT_EQ(data.getData().size(), db::DEFAULT_PAGE_SIZE);
+  }
+  EXPECT_TRUE(scan.done());
+  EXPECT_TRUE(scan.next().second.getData().empty());
+  EXPECT_EQ(db.get(name).getReads().size(), size);
+}
+
+TEST(SharedScanTest, joinInProgress) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  constexpr size_t size = 2 * db::DEFAULT_NUM_PAGES;
+  constexpr size_t lead = 10;
+  createPages(db.get(name), size);
+
+  db::SharedScan first = bufferPool.beginSharedScan(name);
+  std::set<size_t> firstPages;
+  for (size_t i = 0; i < lead; i++) {
+    firstPages.insert(first.next().first);
+  }
+  db::SharedScan second = bufferPool.beginSharedScan(name);
+  EXPECT_EQ(second.getStart(), lead - 1);
+  std::set<size_t> secondPages;
+  while (!first.done() || !second.done()) {
+    if (!first.done()) {
+      firstPages.insert(first.next().first);
+    }
+    if (!second.done()) {
+      secondPages.insert(second.next().first);
+    }
+  }
+  EXPECT_EQ(firstPages.size(), size);
+  EXPECT_EQ(secondPages.size(), size);
+  // only the pages the second scan missed before it joined are read twice
+  EXPECT_EQ(db.get(name).getReads().size(), size + lead - 1);
+}
+
+TEST(SharedScanTest, heldPageStaysPinned) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::TempDbFile>(name));
+  constexpr size_t size = 4 * db::DEFAULT_RING_PAGES;
+  for (size_t i = 0; i < size; i++) {
+    db::Page page{};
+    page[0] = static_cast<char>(i);
+    db.get(name).writePage(page, i);
+  }
+  db::SharedScan scan = bufferPool.beginSharedScan(name);
+  auto [held, guard] = scan.next();
+  EXPECT_EQ(held, 0);
+  while (!scan.done()) {
+    auto [page, data] = scan.next();
+    EXPECT_EQ(data.getData()[0], static_cast<char>(page));
+  }
+  // the ring went around several times without recycling the frame of the held page
+  EXPECT_TRUE(bufferPool.contains({name, 0}));
+  EXPECT_EQ(guard.getData()[0], 0);
+  EXPECT_ANY_THROW(bufferPool.discardPage({name, 0}));
+  guard.release();
+  EXPECT_NO_THROW(bufferPool.discardPage({name, 0}));
+}
+
+TEST(SharedScanTest, groupEnds) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  createPages(db.get(name), 4);
+  {
+    db::SharedScan scan = bufferPool.beginSharedScan(name);
+    scan.next();
+    scan.next();
+  }
+  db::SharedScan scan = bufferPool.beginSharedScan(name);
+  EXPECT_EQ(scan.getStart(), 0);
+
+  std::string empty{"empty"};
+  db.add(std::make_unique<db::DbFile>(empty));
+  db::SharedScan none = bufferPool.beginSharedScan(empty);
+  EXPECT_TRUE(none.done());
+}
@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/PageGuard.hpp>
+#include <db/StaticTupleDesc.hpp>
+
+using Schema = db::StaticTupleDesc<int, double>;
+using Row = std::array<char, Schema::length>;
+
+static Row makeRow(int key, double value) {
+  Row row;
+  Schema::serialize(row.data(), key, value);
+  return row;
+}
+
+static double readValue(db::TransactionManager &tm, const db::Transaction &txn, const db::TupleId &tid) {
+  Row row;
+  tm.read(txn, tid, row);
+  return Schema::get<1>(row.data());
+}
+
+static void loadPage(const db::PageId &pid, size_t tuples) {
+  db::WritePageGuard guard = db::getDatabase().getBufferPool().fetchWrite(pid);
+  db::setTupleCount(guard.getData(), 0);
+  for (size_t i = 0; i < tuples; i++) {
+    Schema::appendTuple(guard.getData(), static_cast<int>(i), 0.0);
+  }
+}
+
+TEST(TransactionTest, snapshotIsolation) {
+  db::Database &db = db::getDatabase();
+  db::TransactionManager &tm = db.getTransactionManager();
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  loadPage({name, 0}, 4);
+  db::TupleId tid{{name, 0}, 2};
+
+  db::Transaction reader = tm.begin();
+  db::Transaction writer = tm.begin();
+  tm.write(writer, tid, makeRow(2, 1.0));
+  EXPECT_EQ(readValue(tm, writer, tid), 1.0);
+  EXPECT_EQ(readValue(tm, reader, tid), 0.0);
+  tm.commit(writer);
+  EXPECT_GT(writer.commitTs, writer.startTs);
+  EXPECT_EQ(readValue(tm, reader, tid), 0.0);
+
+  db::Transaction later = tm.begin();
+  EXPECT_EQ(readValue(tm, later, tid), 1.0);
+  tm.write(later, tid, makeRow(2, 2.0));
+  tm.write(later, tid, makeRow(2, 3.0));
+  EXPECT_EQ(readValue(tm, reader, tid), 0.0);
+  tm.commit(later);
+  EXPECT_EQ(readValue(tm, reader, tid), 0.0);
+  EXPECT_EQ(readValue(tm, tm.begin(), tid), 3.0);
+  EXPECT_THROW(tm.commit(later), std::logic_error);
+  Row row;
+  EXPECT_THROW(tm.read(reader, {{name, 0}, 4}, row), std::out_of_range);
+  std::array<char, sizeof(int)> key;
+  EXPECT_THROW(tm.read(reader, tid, key), std::invalid_argument);
+}
+
+TEST(TransactionTest, firstWriterWins) {
+  db::Database &db = db::getDatabase();
+  db::TransactionManager &tm = db.getTransactionManager();
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  loadPage({name, 0}, 4);
+  db::TupleId tid{{name, 0}, 1};
+
+  db::Transaction first = tm.begin();
+  db::Transaction second = tm.begin();
+  tm.write(first, tid, makeRow(1, 1.0));
+  EXPECT_THROW(tm.write(second, tid, makeRow(1, 2.0)), std::runtime_error);
+  tm.commit(first);
+  db.getBufferPool().flushPage({name, 0});
+  // committed after second started
+  EXPECT_THROW(tm.write(second, tid, makeRow(1, 2.0)), std::runtime_error);
+  EXPECT_FALSE(db.getBufferPool().isDirty({name, 0}));
+  tm.abort(second);
+
+  db::Transaction third = tm.begin();
+  tm.write(third, tid, makeRow(1, 3.0));
+  tm.write(third, {{name, 0}, 3}, makeRow(3, 3.0));
+  tm.abort(third);
+  db::Transaction check = tm.begin();
+  EXPECT_EQ(readValue(tm, check, tid), 1.0);
+  EXPECT_EQ(readValue(tm, check, {{name, 0}, 3}), 0.0);
+  db::ReadPageGuard guard = db.getBufferPool().fetchRead({name, 0});
+  EXPECT_EQ(Schema::get<1>(guard.getData().data() + db::TUPLE_PAGE_HEADER + 3 * Schema::length), 0.0);
+}
+
+TEST(TransactionTest, garbageCollection) {
+  db::Database &db = db::getDatabase();
+  db::TransactionManager &tm = db.getTransactionManager();
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  loadPage({name, 0}, 1);
+  db::TupleId tid{{name, 0}, 0};
+
+  db::Transaction reader = tm.begin();
+  for (int i = 1; i <= 3; i++) {
+    db::Transaction txn = tm.begin();
+    tm.write(txn, tid, makeRow(0, i));
+    tm.commit(txn);
+  }
+  db::Transaction middle = tm.begin();
+  db::Transaction writer = tm.begin();
+  tm.write(writer, tid, makeRow(0, 4.0));
+  EXPECT_EQ(tm.getUndoSize(), 4 * Schema::length);
+
+  // reader needs the initial version, so nothing can go
+  EXPECT_EQ(tm.collectGarbage(), 0);
+  tm.commit(reader);
+  // middle sees version 3, versions 0 to 2 are dead
+  EXPECT_EQ(tm.collectGarbage(), 3);
+  EXPECT_EQ(readValue(tm, middle, tid), 3.0);
+  EXPECT_EQ(tm.getUndoSize(), Schema::length);
+  tm.commit(middle);
+  tm.commit(writer);
+  EXPECT_EQ(tm.collectGarbage(), 1);
+  EXPECT_EQ(tm.getUndoSize(), 0);
+  EXPECT_EQ(readValue(tm, tm.begin(), tid), 4.0);
+
+  db::Transaction txn = tm.begin();
+  tm.write(txn, tid, makeRow(0, 5.0));
+  tm.commit(txn);
+  db.remove(name);
+  EXPECT_EQ(tm.getUndoSize(), 0);
+}
+
+TEST(TransactionTest, guardAborts) {
+  db::Database &db = db::getDatabase();
+  db::TransactionManager &tm = db.getTransactionManager();
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  loadPage({name, 0}, 1);
+  db::TupleId tid{{name, 0}, 0};
+
+  {
+    db::TransactionGuard committed = tm.beginGuarded();
+    tm.write(committed.getTransaction(), tid, makeRow(0, 1.0));
+    committed.commit();
+  }
+  EXPECT_EQ(readValue(tm, tm.beginGuarded().getTransaction(), tid), 1.0);
+
+  {
+    db::TransactionGuard abandoned = tm.beginGuarded();
+    tm.write(abandoned.getTransaction(), tid, makeRow(0, 2.0));
+    db::TransactionGuard moved = std::move(abandoned);
+    EXPECT_THROW(abandoned.commit(), std::logic_error);
+  }
+  // the abandoned writer was rolled back, and it no longer holds back the garbage collector
+  db::TransactionGuard reader = tm.beginGuarded();
+  EXPECT_EQ(readValue(tm, reader.getTransaction(), tid), 1.0);
+  reader.abort();
+  EXPECT_EQ(tm.collectGarbage(), 1);
+  EXPECT_EQ(tm.getUndoSize(), 0);
+}
+
+TEST(TransactionTest, abortAfterRemove) {
+  db::Database &db = db::getDatabase();
+  db::TransactionManager &tm = db.getTransactionManager();
+  std::string removed{"removed"};
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(removed));
+  db.add(std::make_unique<db::DbFile>(name));
+  loadPage({removed, 0}, 1);
+  loadPage({name, 0}, 1);
+
+  db::Transaction txn = tm.begin();
+  tm.write(txn, {{name, 0}, 0}, makeRow(0, 1.0));
+  tm.write(txn, {{removed, 0}, 0}, makeRow(0, 1.0));
+  db.remove(removed);
+  EXPECT_ANY_THROW(tm.abort(txn));
+  // the other tuple was restored and the transaction finished anyway
+  EXPECT_FALSE(txn.active);
+  EXPECT_EQ(readValue(tm, tm.beginGuarded().getTransaction(), {{name, 0}, 0}), 0.0);
+  db::Transaction later = tm.begin();
+  tm.write(later, {{name, 0}, 0}, makeRow(0, 2.0));
+  tm.commit(later);
+  EXPECT_EQ(tm.collectGarbage(), 1);
+  EXPECT_EQ(tm.getUndoSize(), 0);
+}
@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+
+#include <db/StaticTupleDesc.hpp>
+
+using Schema = db::StaticTupleDesc<int, double, std::string, int>;
+
+static_assert(Schema::offsets == std::array<size_t, 4>{0, 4, 12, 76});
+static_assert(Schema::length == 80);
+static_assert(Schema::pageCapacity(db::DEFAULT_PAGE_SIZE) == 51);
+
+TEST(TupleDescTest, runtimeLayout) {
+  db::TupleDesc td = Schema::runtime();
+  EXPECT_EQ(td, db::TupleDesc({db::INT, db::DOUBLE, db::CHAR, db::INT}));
+  EXPECT_EQ(td.getLength(), Schema::length);
+  for (size_t i = 0; i < Schema::NUM_FIELDS; i++) {
+    EXPECT_EQ(td.offsetOf(i), Schema::offsets[i]);
+  }
+  EXPECT_FALSE(td.compatible(db::Tuple({1, 2.0, std::string("x")})));
+  EXPECT_FALSE(td.compatible(db::Tuple({1, 2, std::string("x"), 3})));
+  EXPECT_TRUE(td.compatible(db::Tuple({1, 2.0, std::string("x"), 3})));
+  EXPECT_THROW(db::TupleDesc({}), std::invalid_argument);
+}
+
+TEST(TupleDescTest, sameBytes) {
+  db::TupleDesc td = Schema::runtime();
+  db::Tuple tuple({7, 1.5, std::string("seven"), -7});
+  std::array<char, Schema::length> generic{};
+  std::array<char, Schema::length> specialized{};
+  td.serialize(generic.data(), tuple);
+  Schema::serialize(specialized.data(), 7, 1.5, "seven", -7);
+  EXPECT_EQ(generic, specialized);
+
+  EXPECT_EQ(td.deserialize(specialized.data()), tuple);
+  EXPECT_EQ(Schema::deserialize(generic.data()), tuple);
+  EXPECT_EQ(Schema::get<2>(generic.data()), "seven");
+  EXPECT_EQ(Schema::get<3>(generic.data()), -7);
+
+  std::string tooLong(db::CHAR_SIZE + 1, 'x');
+  EXPECT_THROW(td.serialize(generic.data(), db::Tuple({7, 1.5, tooLong, -7})), std::invalid_argument);
+  EXPECT_THROW(Schema::serialize(specialized.data(), 7, 1.5, tooLong, -7), std::invalid_argument);
+  EXPECT_THROW(td.serialize(generic.data(), db::Tuple({7})), std::invalid_argument);
+}
+
+TEST(TupleDescTest, scanAndFilter) {
+  db::TupleDesc td = Schema::runtime();
+  db::Page page{};
+  for (int i = 0;; i++) {
+    if (i % 2 == 0 ? !Schema::appendTuple(page, i, i / 2.0, std::to_string(i), i % 3)
+                   : !td.appendTuple(page, db::Tuple({i, i / 2.0, std::to_string(i), i % 3}))) {
+      EXPECT_EQ(i, Schema::pageCapacity(page.size()));
+      break;
+    }
+  }
+
+  std::vector<db::Tuple> generic;
+  std::vector<db::Tuple> specialized;
+  td.scanPage(page, [&](const db::Tuple &tuple) { generic.push_back(tuple); });
+  Schema::scanPage(page, [&](Schema::Row row) {
+    specialized.push_back(db::Tuple({row.get<0>(), row.get<1>(), std::string(row.get<2>()), row.get<3>()}));
+  });
+  ASSERT_EQ(generic.size(), db::getTupleCount(page));
+  EXPECT_EQ(generic, specialized);
+  EXPECT_EQ(generic[5], db::Tuple({5, 2.5, std::string("5"), 2}));
+
+  std::vector<size_t> slots = td.filter(page, 3, [](const db::field_t &f) { return std::get<int>(f) == 0; });
+  EXPECT_EQ(slots, Schema::filter<3>(page, [](int f) { return f == 0; }));
+  EXPECT_EQ(slots.size(), 17);
+  EXPECT_EQ(Schema::filter<2>(page, [](std::string_view f) { return f == "42"; }), std::vector<size_t>{42});
+}
+
+TEST(TupleDescTest, damagedCount) {
+  db::TupleDesc td = Schema::runtime();
+  db::Page page{};
+  for (int i = 0; Schema::appendTuple(page, i, 0.0, "", i); i++) {
+  }
+  const size_t capacity = Schema::pageCapacity(page.size());
+  db::setTupleCount(page, UINT32_MAX);
+  EXPECT_EQ(td.tupleCount(page), capacity);
+  EXPECT_EQ(Schema::tupleCount(page), capacity);
+
+  size_t generic = 0;
+  size_t specialized = 0;
+  td.scanPage(page, [&](const db::Tuple &) { generic++; });
+  Schema::scanPage(page, [&](Schema::Row) { specialized++; });
+  EXPECT_EQ(generic, capacity);
+  EXPECT_EQ(specialized, capacity);
+  EXPECT_EQ(td.filter(page, 0, [](const db::field_t &) { return true; }).size(), capacity);
+  EXPECT_EQ(Schema::filter<0>(page, [](int) { return true; }).size(), capacity);
+  EXPECT_FALSE(td.appendTuple(page, db::Tuple({1, 1.0, std::string("x"), 1})));
+  EXPECT_FALSE(Schema::appendTuple(page, 1, 1.0, "x", 1));
+}
@@ -0,0 +1,205 @@
+#include <gtest/gtest.h>
+
+#include <db/Database.hpp>
+#include <db/TempDbFile.hpp>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <thread>
+
+static std::string dumpPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+static std::vector<db::PageId> readDumpFile(const std::string &path) {
+  std::vector<db::PageId> pages;
+  std::ifstream in(path);
+  db::PageId pid;
+  while (in >> pid.page && in.get() == '\t' && std::getline(in, pid.file)) {
+    pages.push_back(pid);
+  }
+  return pages;
+}
+
+/**
+ * A file whose reads wait until the gate is opened.
+ */
+class GatedReadFile : public db::TempDbFile {
+  std::shared_future<void> gate;
+
+public:
+  mutable std::atomic<size_t> reads{0};
+
+  GatedReadFile(const std::string &name, std::shared_future<void> gate) : TempDbFile(name), gate(std::move(gate)) {}
+
+  void readPages(std::span<char> pages, size_t id) const override {
+    reads++;
+    gate.wait();
+    TempDbFile::readPages(pages, id);
+  }
+};
+
+/**
+ * Adds a gated file with a single page of 'p's and starts prefetching that page into the bufferpool, returning
+ * once the read is blocked on the gate.
+ */
+static const GatedReadFile &prefetchGated(db::BufferPool &bufferPool, const std::string &path,
+                                          std::shared_future<void> gate) {
+  db::Database &db = db::getDatabase();
+  auto gated = std::make_unique<GatedReadFile>("gated", std::move(gate));
+  db::Page page;
+  page.fill('p');
+  gated->writePage(page, 0);
+  const GatedReadFile &file = *gated;
+  db.add(std::move(gated));
+  {
+    std::ofstream out(path, std::ios::trunc);
+    out << 0 << '\t' << "gated" << '\n';
+  }
+  bufferPool.enableWarmStart(path);
+  while (file.reads == 0) {
+    std::this_thread::yield();
+  }
+  return file;
+}
+
+TEST(WarmStartTest, dumpOrder) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  std::string path = dumpPath("warmstart_order");
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  for (size_t i = 0; i < 5; i++) {
+    bufferPool.getPage({name, i});
+  }
+  bufferPool.getPage({name, 1});
+  bufferPool.dumpResidentPages(path);
+
+  std::vector<db::PageId> expected{{name, 1}, {name, 4}, {name, 3}, {name, 2}, {name, 0}};
+  EXPECT_EQ(bufferPool.getResidentPages(), expected);
+  EXPECT_EQ(readDumpFile(path), expected);
+  EXPECT_FALSE(std::filesystem::exists(path + ".tmp"));
+  std::filesystem::remove(path);
+}
+
+TEST(WarmStartTest, restore) {
+  db::Database &db = db::getDatabase();
+  db::BufferPool &bufferPool = db.getBufferPool();
+  std::string path = dumpPath("warmstart_restore");
+  std::filesystem::remove(path);
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+    bufferPool.getPage({name, i});
+  }
+  {
+    db::BufferPool previous;
+    for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+      previous.getPage({name, i});
+    }
+    previous.enableWarmStart(path);
+  }
+  ASSERT_EQ(readDumpFile(path).size(), db::DEFAULT_NUM_PAGES);
+
+  const std::vector<size_t> &reads = db.get(name).getReads();
+  size_t before = reads.size();
+  db::BufferPool restored;
+  restored.enableWarmStart(path);
+  restored.awaitWarmStart();
+
+  // hottest batch first, each batch in file order
+  std::vector<size_t> expected;
+  for (size_t i = db::DEFAULT_NUM_PAGES - db::WARM_START_BATCH; i < db::DEFAULT_NUM_PAGES; i++) {
+    expected.push_back(i);
+  }
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES - db::WARM_START_BATCH; i++) {
+    expected.push_back(i);
+  }
+  EXPECT_EQ(std::vector<size_t>(reads.begin() + before, reads.end()), expected);
+  for (size_t i = 0; i < db::DEFAULT_NUM_PAGES; i++) {
+    EXPECT_TRUE(restored.contains({name, i}));
+  }
+  std::filesystem::remove(path);
+}
+
+TEST(WarmStartTest, periodicDump) {
+  db::Database &db = db::getDatabase();
+  std::string path = dumpPath("warmstart_periodic");
+  std::filesystem::remove(path);
+
+  std::string name{"file"};
+  db.add(std::make_unique<db::DbFile>(name));
+  db::BufferPool bufferPool;
+  bufferPool.enableWarmStart(path, std::chrono::milliseconds(10));
+  bufferPool.awaitWarmStart();
+  bufferPool.getPage({name, 7});
+  EXPECT_THROW(bufferPool.enableWarmStart(path), std::logic_error);
+
+  for (int i = 0; i < 500 && readDumpFile(path).empty(); i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  std::vector<db::PageId> expected{{name, 7}};
+  EXPECT_EQ(readDumpFile(path), expected);
+  std::filesystem::remove(path);
+}
+
+TEST(WarmStartTest, noEviction) {
+  db::Database &db = db::getDatabase();
+  std::string path = dumpPath("warmstart_large");
+
+  std::string name{"file"};
+  std::string removed{"removed"};
+  db.add(std::make_unique<db::DbFile>(name));
+  {
+    std::ofstream out(path, std::ios::trunc);
+    out << 0 << '\t' << removed << '\n';
+    for (size_t i = 0; i < 2 * db::DEFAULT_NUM_PAGES; i++) {
+      out << i << '\t' << name << '\n';
+    }
+  }
+
+  db::BufferPool bufferPool;
+  bufferPool.getPage({name, 1000});
+  bufferPool.enableWarmStart(path);
+  bufferPool.awaitWarmStart();
+
+  const std::vector<size_t> &reads = db.get(name).getReads();
+  EXPECT_EQ(reads.size(), db::DEFAULT_NUM_PAGES);
+  EXPECT_TRUE(bufferPool.contains({name, 1000}));
+  EXPECT_EQ(bufferPool.getResidentPages().front(), db::PageId({name, 1000}));
+  EXPECT_TRUE(db.get(name).getWrites().empty());
+  std::filesystem::remove(path);
+}
+
+TEST(WarmStartTest, missWaitsForPrefetch) {
+  std::string path = dumpPath("warmstart_inflight");
+  std::promise<void> open;
+  db::BufferPool bufferPool;
+  const GatedReadFile &file = prefetchGated(bufferPool, path, open.get_future().share());
+
+  std::future<char> first = std::async(std::launch::async, [&] { return bufferPool.getPage({"gated", 0})[0]; });
+  EXPECT_EQ(first.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+  open.set_value();
+  EXPECT_EQ(first.get(), 'p');
+  bufferPool.awaitWarmStart();
+  EXPECT_EQ(file.reads, 1);
+  std::filesystem::remove(path);
+}
+
+TEST(WarmStartTest, discardWaitsForPrefetch) {
+  std::string path = dumpPath("warmstart_discard");
+  std::promise<void> open;
+  db::BufferPool bufferPool;
+  prefetchGated(bufferPool, path, open.get_future().share());
+
+  std::future<void> discarded = std::async(std::launch::async, [&] { bufferPool.discardFile("gated"); });
+  EXPECT_EQ(discarded.wait_for(std::chrono::milliseconds(50)), std::future_status::timeout);
+  open.set_value();
+  discarded.get();
+  bufferPool.awaitWarmStart();
+  EXPECT_FALSE(bufferPool.contains({"gated", 0}));
+  std::filesystem::remove(path);
+}